@@ -0,0 +1,19 @@
+TEMPLATE = app
+include(FTEdit.pri)
+TARGET = ftedit-bench
+CONFIG += console
+CONFIG -= app_bundle
+QT -= gui
+
+DESTDIR = release
+OBJECTS_DIR = .build/.bench
+
+INCLUDEPATH += \
+$$PWD/inc/bench \
+
+HEADERS += \
+inc/bench/TreeGenerator.hh
+
+SOURCES += \
+src/bench/TreeGenerator.cc \
+src/bench/main.cc
@@ -0,0 +1,12 @@
+TEMPLATE = app
+include(FTEdit.pri)
+TARGET = ftedit-cli
+CONFIG += console
+CONFIG -= app_bundle
+QT -= gui
+
+DESTDIR = release
+OBJECTS_DIR = .build/.cli
+
+SOURCES += \
+src/cli/main.cc
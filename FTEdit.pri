@@ -0,0 +1,97 @@
+# Sources shared by the graphical editor (Makefile.pro) and the command line runner (Cli.pro)
+CONFIG += object_parallel_to_source
+QMAKE_CXXFLAGS += -Wall -Wextra -Werror
+# Let g++ vectorize the kernels (src/editor/DistributionKernels.cc, src/evaluator/Kernels.cc)
+*-g++* {
+	QMAKE_CXXFLAGS_RELEASE += -fvect-cost-model=dynamic -fno-trapping-math
+}
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += \
+$$PWD/inc \
+$$PWD/inc/editor \
+$$PWD/inc/evaluator \
+$$PWD/inc/fms \
+
+HEADERS += \
+inc/editor/Container.hh \
+inc/editor/Distribution.hh \
+inc/editor/DistributionKernels.hh \
+inc/editor/Editor.hh \
+inc/editor/Event.hh \
+inc/editor/FTEdit_Editor.hh \
+inc/editor/Gate.hh \
+inc/editor/Node.hh \
+inc/editor/NamePool.hh \
+inc/editor/Properties.hh \
+inc/editor/Transfert.hh \
+inc/editor/Tree.hh \
+inc/editor/VisitorNode.hh \
+inc/editor/VisitorDistribution.hh \
+inc/editor/ClipVisitor.hh \
+inc/editor/PasteVisitor.hh \
+inc/evaluator/FTEdit_Evaluator.hh \
+inc/evaluator/EvalVisitor.hh \
+inc/evaluator/CutVisitor.hh \
+inc/evaluator/CompileVisitor.hh \
+inc/evaluator/CompiledTree.hh \
+inc/evaluator/EventTable.hh \
+inc/evaluator/Kernels.hh \
+inc/evaluator/CutSet.hh \
+inc/evaluator/Evaluator.hh \
+inc/evaluator/Progress.hh \
+inc/evaluator/ResultMCS.hh \
+inc/evaluator/ResultBoolean.hh \
+inc/evaluator/ResultBDD.hh \
+inc/evaluator/Bdd.hh \
+inc/evaluator/BddVisitor.hh \
+inc/evaluator/Result.hh \
+inc/fms/FileManagerSystem.hh \
+inc/fms/FTEdit_FMS.hh \
+inc/fms/Journal.hh \
+inc/fms/SaveVisitor.hh \
+inc/fms/SnapshotFile.hh \
+inc/fms/XmlTreeReader.hh
+
+SOURCES += \
+src/editor/And.cc \
+src/editor/Constant.cc \
+src/editor/Container.cc \
+src/editor/Distribution.cc \
+src/editor/DistributionKernels.cc \
+src/editor/Editor.cc \
+src/editor/Event.cc \
+src/editor/Exponential.cc \
+src/editor/Gate.cc \
+src/editor/Inhibit.cc \
+src/editor/Node.cc \
+src/editor/Or.cc \
+src/editor/NamePool.cc \
+src/editor/Properties.cc \
+src/editor/Transfert.cc \
+src/editor/Tree.cc \
+src/editor/VotingOR.cc \
+src/editor/Weibull.cc \
+src/editor/Xor.cc \
+src/editor/ClipVisitor.cc \
+src/editor/PasteVisitor.cc \
+src/evaluator/EvalVisitor.cc \
+src/evaluator/CutVisitor.cc \
+src/evaluator/CompileVisitor.cc \
+src/evaluator/CompiledTree.cc \
+src/evaluator/EventTable.cc \
+src/evaluator/Kernels.cc \
+src/evaluator/CutSet.cc \
+src/evaluator/Evaluator.cc \
+src/evaluator/Progress.cc \
+src/evaluator/ResultMCS.cc \
+src/evaluator/ResultBoolean.cc \
+src/evaluator/ResultBDD.cc \
+src/evaluator/Bdd.cc \
+src/evaluator/BddVisitor.cc \
+src/evaluator/Result.cc \
+src/fms/FileManagerSystem.cc \
+src/fms/Journal.cc \
+src/fms/SaveVisitor.cc \
+src/fms/SnapshotFile.cc \
+src/fms/XmlTreeReader.cc
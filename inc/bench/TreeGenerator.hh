@@ -0,0 +1,45 @@
+#pragma once
+#include <random>
+#include "FTEdit_Editor.hh"
+
+// Shape of a synthetic fault tree
+struct TreeShape
+{
+	int		depth = 4; // levels of gates below the top gate
+	int		fanOut = 3; // children of And, Or and VotingOR gates
+	// Relative weights of the gate types
+	int		andWeight = 2;
+	int		orWeight = 3;
+	int		xorWeight = 0;
+	int		votingWeight = 1;
+	int		inhibitWeight = 1;
+	double	sharedRatio = 0.3; // probability that a leaf reuses an existing event
+	int		votingK = 2; // k of the VotingOR gates, bounded by fanOut
+	int		transferts = 0; // length of the chain of trees linked by Transfert
+	unsigned	seed = 1;
+};
+
+// Builds synthetic fault trees directly in an Editor
+class TreeGenerator
+{
+private:
+	Editor			&editor;
+	TreeShape		shape;
+	std::mt19937	rng;
+	int				nbGates;
+	int				nbLeaves;
+
+	QString	newName(const QString &prefix);
+	Gate	*newGate();
+	Node	*newLeaf();
+	Gate	*generate(int depth, Tree *link, bool &linked);
+
+public:
+	TreeGenerator(Editor &editor, const TreeShape &shape);
+	~TreeGenerator();
+
+	// Creates the trees of the transfer chain, returns the top gate of the first one
+	Gate	*generate();
+	int		getNbGates() const;
+	int		getNbLeaves() const;
+};
@@ -17,6 +17,8 @@ public:
 	double		getValue();
 	void	setValue(double value);
 	virtual double	getProbability(double time) = 0;
+	// out[i] = getProbability(times[i]) with vectorized kernels
+	virtual void	getProbabilities(const double *times, double *out, int n) = 0;
 	virtual void 	accept(VisitorDistribution& visitor) = 0;
 };
 
@@ -27,6 +29,7 @@ public:
 	~Constant();
 
 	double	getProbability(double time);
+	void	getProbabilities(const double *times, double *out, int n);
 	void 	accept(VisitorDistribution& visitor);
 };
 
@@ -38,6 +41,7 @@ public:
 
 	double	getLambda();
 	double	getProbability(double time);
+	void	getProbabilities(const double *times, double *out, int n);
 	void	setLambda(double lambda);
 	void 	accept(VisitorDistribution& visitor);
 };
@@ -53,6 +57,7 @@ public:
 	double	getScale();
 	double	getShape();
 	double	getProbability(double time);
+	void	getProbabilities(const double *times, double *out, int n);
 	void	setScale(double scale);
 	void	setShape(double shape);
 	void	accept(VisitorDistribution& visitor);
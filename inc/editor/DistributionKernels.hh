@@ -0,0 +1,17 @@
+#pragma once
+#include <QtGlobal>
+
+// Array kernels of the probability laws, written so that the compiler can vectorize them
+// On x86-64 Linux an AVX2 version is selected at run time when the processor supports it
+#if defined(__x86_64__) && defined(__linux__) && (defined(__GNUC__) || defined(__clang__))
+# define FTEDIT_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+# define FTEDIT_KERNEL
+#endif
+
+// out[i] = 1 - exp(-lambda * times[i])
+void	exponentialKernel(double lambda, const double *times, double *out, int n);
+// out[i] = 1 - exp(-pow(times[i] / scale, shape))
+void	weibullKernel(double scale, double shape, const double *times, double *out, int n);
+// out[i] = 1 - exp(-pow(time / scales[i], shapes[i])), several events at the same time
+void	weibullEventsKernel(double time, const double *scales, const double *shapes, double *out, int n);
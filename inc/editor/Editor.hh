@@ -1,4 +1,6 @@
 #pragma once
+#include <QHash>
+#include <QSet>
 #include "Distribution.hh"
 #include "Event.hh"
 #include "Gate.hh"
@@ -22,6 +24,9 @@ private:
 	Node					*clipboard;
 	Tree					*selection;
 	bool					autoRefresh;
+	QHash<int, int>			names; // nombre d'objets de l'éditeur portant chaque nom, par id dans le NamePool (une référence chacun)
+	QHash<QString, uint>	counters; // prochain suffixe à essayer pour chaque préfixe
+	QSet<QString>			freedNames; // noms libérés depuis le dernier autosave
 
 public:
 	Editor(bool autoRefresh = true);
@@ -33,9 +38,11 @@ public:
 	QList<Gate*>			&getGates();
 	Node					*getClipboard();
 	Tree					*getSelection();
+	const QSet<QString>		&getFreedNames();
 
 	void	setSelection(Tree *selection);
 	void	setAutoRefresh(bool value = true);
+	void	clearFreedNames();
 
 	// Copie la structure d'un sous-arbre
 	void	copy(Node *top);
@@ -55,6 +62,12 @@ public:
 	QString	generateName(QString prefix);
 	// Vérifie si name est déjà utilisé dans un objet de l'éditeur
 	bool	isUnique(QString name);
+	// Enregistre le nom d'un objet ajouté à l'éditeur
+	void	addName(QString name);
+	// Libère le nom d'un objet retiré de l'éditeur
+	void	removeName(QString name);
+	// Renomme un objet de l'éditeur, les objets qui le désignent sont marqués comme modifiés
+	void	rename(Properties &prop, QString name);
 	// Mise à jour des listes d'objets de l'éditeur (détruit les objets non utilisés)
 	void	refresh();
 	// Réinitialise le presse-papier
@@ -1,5 +1,6 @@
 #pragma once
 #include <QList>
+#include <QVector>
 #include "Node.hh"
 #include "Properties.hh"
 
@@ -11,6 +12,16 @@ class Gate : public Node
 protected:
 	Properties prop;
 	QList<Node*> children;
+	// Layout cache, relative to the position of the gate
+	bool collapsed; // children hidden in the view
+	bool dirty; // children changed since the last layout
+	bool placed; // children placed under the current position
+	QVector<int> offsets; // x of each child
+	QVector<int> contourLeft; // x of the leftmost and rightmost nodes at each depth of the subtree
+	QVector<int> contourRight;
+
+	void layout();
+	void place(QPoint position);
 public:
 	Gate(QString name,bool keep = true);
 	virtual ~Gate();
@@ -18,6 +29,10 @@ public:
 	Properties&		getProperties();
 	QList<Node*>&	getChildren();
 	void 	balanceNodePos();	
+	// Must be called when the children are changed without attach() or detach()
+	void	invalidateLayout();
+	bool	isCollapsed();
+	void	setCollapsed(bool collapsed);
 	Node*	search(QPoint around);
 	void	remove();
 };
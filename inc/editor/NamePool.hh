@@ -0,0 +1,19 @@
+#pragma once
+#include <QString>
+
+// Table of the names of the objects of every editor, each name is stored once
+// Two names are equal if and only if their ids are equal
+// A name stays in the pool while it has references, its id can then be given to another name
+class NamePool
+{
+public:
+	// Returns the id of name, adding it to the pool if needed, and takes a reference to it
+	// name is replaced by the copy kept in the pool, which shares its characters
+	static int	intern(QString &name);
+	// Takes another reference to the name of id
+	static void	retain(int id);
+	// Releases a reference taken by intern() or retain()
+	static void	release(int id);
+	// Returns -1 if name is not in the pool
+	static int	find(const QString &name);
+};
@@ -1,25 +1,34 @@
 #pragma once
 #include <QString>
+#include "NamePool.hh"
 
 class Properties
 {
 protected:
-	QString	name;
+	QString	name; // shares its characters with the NamePool
+	int		nameId; // equal names have the same id, each Properties holds a reference to it
 	QString	desc;
 	int		refCount;
 	bool	keep;
+	bool	changed; // modified since the last autosave
 
 public:
 	Properties(QString name, bool keep = false);
+	Properties(const Properties &other);
 	~Properties();
 
+	Properties	&operator=(const Properties &other);
+
 	QString	getName() const;
+	int		getNameId() const;
 	QString	getDesc() const;
 	int		getRefCount() const;
 	bool	getKeep() const;
+	bool	isChanged() const;
 	void	setName(QString name);
 	void	setDesc(QString desc);
 	void	setKeep(bool keep);
+	void	setChanged(bool changed = true);
 	void	decrementRefCount();
 	void	incrementRefCount();
 	bool	canBeRemoved();
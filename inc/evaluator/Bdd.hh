@@ -0,0 +1,68 @@
+#pragma once
+#include <QHash>
+#include <QVector>
+#include "Progress.hh"
+
+#define BDD_FALSE	0
+#define BDD_TRUE	1
+
+// Key of the unique and computed tables
+struct BddKey
+{
+	int a;
+	int b;
+	int c;
+
+	bool operator==(const BddKey &key) const;
+};
+
+uint qHash(const BddKey &key, uint seed = 0);
+
+// Reduced ordered binary decision diagram manager
+// Every function is identified by the index of its root vertex, variables are ordered by index
+class Bdd
+{
+private:
+	struct Vertex
+	{
+		int var;
+		int low; // var = 0
+		int high; // var = 1
+	};
+
+	QVector<Vertex>		vertices;
+	QHash<BddKey, int>	unique; // (var, low, high) -> vertex
+	QHash<BddKey, int>	computed; // (f, g, h) -> ite(f, g, h)
+	int					nbVars;
+	const Progress		*progress; // the operators stop building when it is canceled
+
+	// Returns the reduced vertex (var, low, high)
+	int	makeVertex(int var, int low, int high);
+	int	topVar(int f) const;
+	int	low(int f, int var) const;
+	int	high(int f, int var) const;
+
+public:
+	Bdd(const Progress *progress = nullptr);
+	~Bdd();
+
+	// Returns the function of the variable index var
+	int	variable(int var);
+	// If-then-else operator, every other operator is built on top of it
+	// Returns BDD_FALSE once the progress is canceled: the diagram is then meaningless
+	int	ite(int f, int g, int h);
+	int	negation(int f);
+	int	conjunction(int f, int g);
+	int	disjunction(int f, int g);
+	int	exclusion(int f, int g);
+	// Returns the function true if at least k of the functions are true
+	int	atLeast(int k, const QVector<int> &functions);
+	// Vertices reachable from f, children always come before their parents
+	QVector<int>	reachable(int f) const;
+	// Exact probability of f knowing the probability of each variable
+	double	probability(int f, const QVector<double> &p) const;
+	// Same as above with the vertices given by reachable() and a buffer of getSize() values
+	double	probability(const QVector<int> &order, const QVector<double> &p, QVector<double> &values) const;
+	int		getSize() const;
+	int		getNbVars() const;
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include "FTEdit_Editor.hh"
+#include "Bdd.hh"
+
+// Compiles the gates of a fault tree into a Bdd (one variable per basic event)
+class BddVisitor : public VisitorNode
+{
+private :
+	Bdd&			bdd;
+	QList<Event*>&	events; // events[i] is the variable i
+	QHash<Event*, int>	vars;
+	QHash<Node*, int>	gates; // already compiled gates (shared subtrees)
+	int				result;
+
+	// Returns true if gate was already compiled
+	bool	compiled(Node *gate);
+	QVector<int>	compileChildren(Gate& gate);
+
+public :
+	BddVisitor(Bdd& bdd, QList<Event*>& events);
+	~BddVisitor();
+
+	// Returns the function of the node
+	int	compile(Node *n);
+	void visit(And& andgate);
+	void visit(Or& orgate);
+	void visit(Xor& xorgate);
+	void visit(VotingOR& vorgate);
+	void visit(Inhibit& inhibgate);
+	void visit(Transfert& transfertgate);
+	void visit(Container& container);
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include "FTEdit_Editor.hh"
+
+// Gate lowered to an opcode applied on a range of operands
+struct Instruction
+{
+	enum Opcode { AND, OR, XOR };
+
+	Opcode	op;
+	int		first; // operands[first, last[
+	int		last;
+};
+
+// Lowers the gates of a fault tree into instructions in topological order
+// An operand is the index of a gate instruction, or ~i for the event i
+class CompileVisitor : public VisitorNode
+{
+private :
+	QList<Event*>&			events; // events[i] is the event ~i
+	QVector<Instruction>&	code;
+	QVector<int>&			operands;
+	QHash<Event*, int>		eventSlots;
+	QHash<Node*, int>		gates; // already compiled gates (shared subtrees)
+	int						result;
+
+	void	emitInstruction(Instruction::Opcode op, const QVector<int> &args);
+	QVector<int>	compileChildren(Gate& gate);
+
+public :
+	CompileVisitor(QList<Event*>& events, QVector<Instruction>& code, QVector<int>& operands);
+	~CompileVisitor();
+
+	// Returns the operand of the node
+	int	compile(Node *n);
+	void visit(And& andgate);
+	void visit(Or& orgate);
+	void visit(Xor& xorgate);
+	void visit(VotingOR& vorgate);
+	void visit(Inhibit& inhibgate);
+	void visit(Transfert& transfertgate);
+	void visit(Container& container);
+};
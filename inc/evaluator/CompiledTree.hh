@@ -0,0 +1,30 @@
+#pragma once
+#include "CompileVisitor.hh"
+#include "EventTable.hh"
+#include "Kernels.hh"
+#include "Progress.hh"
+
+// Flat representation of the tree reachable from a top gate
+// values[0, nbEvents[ are the probabilities of the events, values[nbEvents + i] the result of code[i]
+class CompiledTree
+{
+private:
+	QList<Event*>			events;
+	EventTable				table; // table row i is events[i]
+	QVector<Instruction>	code; // children always come before their parents
+	QVector<int>			operands; // indexes in values
+	QVector<double>			values;
+	int						root; // index of the top gate in values
+
+public:
+	CompiledTree(Gate *top);
+	~CompiledTree();
+
+	// Same result as EvalVisitor::getProba(top, time)
+	double	getProba(double time);
+	// out[i] = getProba(times[i]), every node is evaluated on a block of times at once
+	// Stops early if progress is canceled
+	void	getProbabilities(const double *times, double *out, int n, Progress *progress = nullptr) const;
+	int		getNbEvents() const;
+	int		getNbGates() const;
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include <QList>
+#include <QVector>
+
+// Cut set stored as the sorted indexes of its basic events
+typedef QVector<int> CutSet;
+
+// Keeps the minimal cut sets
+// A cut set is absorbed if one of the retained ones is included in it
+class CutSetMinimizer
+{
+private:
+	QList<CutSet>		cuts; // retained cut sets
+	QVector<QVector<int>>	byFirst; // byFirst[e] = retained cut sets starting with the event e
+
+public:
+	CutSetMinimizer(int nbEvents = 0);
+	~CutSetMinimizer();
+
+	// Sorts the events of a cut set and removes the duplicates
+	static void	normalize(CutSet &cut);
+	// Returns true if a retained cut set is included in cut (must be normalized)
+	bool	isAbsorbed(const CutSet &cut) const;
+	// Retains cut without checking it (must be normalized)
+	void	insert(const CutSet &cut);
+	QList<CutSet>	&getCutSets();
+	// Returns the minimal cut sets sorted by order
+	static QList<CutSet>	minimize(QList<CutSet> &cuts, int nbEvents);
+};
@@ -1,18 +1,33 @@
 #pragma once
 #include "FTEdit_Editor.hh"
+#include "CutSet.hh"
+
+// Cut set being expanded by MOCUS
+struct PartialCut
+{
+    CutSet events;//index des events de base deja trouves (tries)
+    QVector<Node*> gates;//portes restant a developper
+};
 
 class CutVisitor : public VisitorNode
 {
 private :
-    QList<QList<Node*>>& cutset;
-    QList<Container*>& containers;
-    int i;//index de cutset[i][j]
-    int j;//index de cutset[i][j]
+    QList<Event*>& events;//events[i] est l'event d'index i dans les coupes
+    QVector<PartialCut>& work;//coupes partielles a developper
+    QHash<Event*, int> index;
+    QHash<Inhibit*, Container*> conditions;//condition de chaque porte inhibit
+    QList<Container*> containers;//conditions alloues dynamiques
+    PartialCut cut;//coupe courante (la porte visitee est deja enlevee)
+
+    int getIndex(Event* e);
+    void add(PartialCut& c, Node* n);//ajouter un fils dans une coupe
 
 public :
-    CutVisitor(QList<QList<Node*>>& cutset, QList<Container*>& containers);
+    CutVisitor(QList<Event*>& events, QVector<PartialCut>& work);
     ~CutVisitor();
 
+    // Remplace gate par ses fils dans cut et ajoute les coupes obtenues dans work
+    void expand(const PartialCut& cut, Node* gate);
     void visit(And& andgate);
     void visit(Or& orgate);
     void visit(Xor& xorgate);
@@ -20,5 +35,4 @@ public :
     void visit(Inhibit& inhibgate);
     void visit(Transfert& transfertgate);
     void visit(Container& container);
-    void setIndex(int i, int j);//donner le visitor les index de la porte courante
 };
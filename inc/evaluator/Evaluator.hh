@@ -1,6 +1,8 @@
 #pragma once
 #include <QList>
+#include <QVector>
 #include "Gate.hh"
+#include "Progress.hh"
 
 class Evaluator{
 protected : 
@@ -8,9 +10,14 @@ protected :
 	double missionTime;
 	double step;
 	QList<double> probabilities;
+	Progress* progress; // peut etre nul
+
+	bool canceled(); // vrai si l'utilisateur a interrompu l'analyse
+
+	QVector<double> getTimes(); // instants evalues, de 0 a missionTime par pas de step
 
 public : 
-	Evaluator(Gate* top,double missionTime, double step);
+	Evaluator(Gate* top,double missionTime, double step, Progress* progress = nullptr);
 	virtual ~Evaluator();
 	double getMissionTime();
 	double getStep();
@@ -0,0 +1,40 @@
+#pragma once
+#include <QVector>
+#include "FTEdit_Editor.hh"
+#include "VisitorDistribution.hh"
+
+// Probability laws of the events of an analysis, stored by column
+// The event i of the analysis is the row i: the inner loops work on indexes
+// and never go back to the Event and Distribution objects
+class EventTable : public VisitorDistribution
+{
+private:
+	enum Kind { CONSTANT, EXPONENTIAL, WEIBULL };
+
+	QVector<int>	kinds; // kind of each row
+	QVector<int>	columns; // index of each row in the parameters of its kind
+	// Rows of each kind and their parameters, each kind is evaluated by a single kernel
+	QVector<int>	constants;
+	QVector<double>	values;
+	QVector<int>	exponentials;
+	QVector<double>	lambdas;
+	QVector<int>	weibulls;
+	QVector<double>	scales;
+	QVector<double>	shapes;
+	QVector<double>	tmp; // results of a kernel, before they are scattered to the rows
+
+public:
+	EventTable();
+	~EventTable();
+
+	// Adds a row for event, returns its index
+	int		append(Event *event);
+	int		size() const;
+	// out[i] = probability of the event i at time
+	void	getProbabilities(double time, double *out);
+	// out[j] = probability of the event i at times[j]
+	void	getProbabilities(int i, const double *times, double *out, int n) const;
+	void	visit(Constant& constdistrib);
+	void	visit(Exponential& expdistrib);
+	void	visit(Weibull& weibulldistrib);
+};
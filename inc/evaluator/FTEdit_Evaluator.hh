@@ -1,6 +1,10 @@
 #pragma once
+#include "Progress.hh"
 #include "Evaluator.hh"
 #include "ResultMCS.hh"
 #include "Result.hh"
 #include "EvalVisitor.hh"
+#include "CompiledTree.hh"
+#include "EventTable.hh"
 #include "ResultBoolean.hh"
+#include "ResultBDD.hh"
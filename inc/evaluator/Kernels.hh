@@ -0,0 +1,12 @@
+#pragma once
+#include "DistributionKernels.hh"
+
+// Array kernels of the batched evaluation of the gates, vectorized like those of the probability laws
+// r[i] *= a[i]
+void	andKernel(double *r, const double *a, int n);
+// r[i] += a[i]
+void	orKernel(double *r, const double *a, int n);
+// r[i] = qBound(0, r[i], 1)
+void	boundKernel(double *r, int n);
+// r[i] = a[i] * (1 - b[i]) + (1 - a[i]) * b[i]
+void	xorKernel(double *r, const double *a, const double *b, int n);
@@ -0,0 +1,24 @@
+#pragma once
+#include <atomic>
+
+// Progress of an analysis, shared between the thread running it and the user interface
+class Progress
+{
+private:
+	std::atomic<bool>	canceled;
+	std::atomic<int>	done;
+	std::atomic<int>	total; // 0 when unknown
+
+public:
+	Progress();
+	~Progress();
+
+	// Asks the analysis to stop as soon as possible
+	void	cancel();
+	bool	isCanceled() const;
+	// Starts a new step of total units of work
+	void	start(int total);
+	void	advance(int n = 1);
+	int		getDone() const;
+	int		getTotal() const;
+};
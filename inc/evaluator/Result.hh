@@ -2,6 +2,7 @@
 #include <QStringList>
 #include "ResultMCS.hh"
 #include "ResultBoolean.hh"
+#include "ResultBDD.hh"
 
 class Result
 {
@@ -9,11 +10,16 @@ private :
 		QStringList errors;
 		ResultMCS *resultMCS;
 		ResultBoolean *resultBoolean;
+		ResultBDD *resultBDD;
+		bool canceled;
 
 public:
-		Result(Gate* top, bool useMCS,bool useBoolean,double missionTime,double step);
+		Result(Gate* top, bool useMCS,bool useBoolean,bool useBDD,double missionTime,double step,int maxOrder = 0,double cutoff = 0,
+		Progress* progress = nullptr);
 		~Result();
 		QStringList& getErrors();
 		ResultMCS* getResultMCS();
 		ResultBoolean *getResultBoolean();
+		ResultBDD *getResultBDD();
+		bool isCanceled(); // l'analyse a ete interrompue, aucun resultat n'est garde
 };
@@ -0,0 +1,15 @@
+#pragma once
+#include "Evaluator.hh"
+#include "BddVisitor.hh"
+#include "EventTable.hh"
+
+class ResultBDD : public Evaluator
+{
+private :
+	int size; // nombre de sommets du diagramme
+
+public :
+	ResultBDD(Gate* top, double missionTime, double step, Progress* progress = nullptr);
+	~ResultBDD();
+	int getSize();
+};
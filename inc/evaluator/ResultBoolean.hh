@@ -1,10 +1,11 @@
 #pragma once
 #include "Evaluator.hh"
-#include "EvalVisitor.hh"
+#include "CompiledTree.hh"
 
 class ResultBoolean : public Evaluator
 {
 public:
-	ResultBoolean(Gate* top, double missionTime,double step);
+	// nbThreads = 0 : un thread par coeur
+	ResultBoolean(Gate* top, double missionTime,double step, Progress* progress = nullptr, int nbThreads = 0);
 	~ResultBoolean();
 };
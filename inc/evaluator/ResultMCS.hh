@@ -1,22 +1,29 @@
 #pragma once
 #include "Evaluator.hh"
 #include "CutVisitor.hh"
+#include "Bdd.hh"
+#include "CutSet.hh"
 #include "Event.hh"
+#include "EventTable.hh"
 
 class ResultMCS : public Evaluator
 {
 private : 
     QList<QList<QString>> mcsNames;//mettre dedans les noms des events
-    QList<int> sieveOfAtkin(int n);
-    void computeCS(QList<QList<Node*>>& cs, QList<Container*>& containers);
-    void reduceCS(QList<QList<Event>>& mcs);
-    void sortCut(QList<QList<Event>>& mcs);
-    void convertCS(QList<QList<Node*>>& cs, QList<QList<Event>>& mcs);
-    void combo(int n,int k,int a[],QList<QList<int>>& comb,int m);/*calculer les compositions des coupes minimales*/
+    int maxOrder;//ordre maximal des coupes (0 = pas de limite)
+    double cutoff;//proba en dessous de laquelle les coupes partielles sont abandonnees
+    EventTable table;//lois des events, la ligne i est l'event d'index i dans les coupes
+    QVector<double> p;//proba de chaque event a missionTime
+    void computeCS(CutVisitor& visitor, QList<Event*>& events, QVector<PartialCut>& work, QList<CutSet>& cs);
+    void computeProbabilities(QList<Event*>& events);
+    bool truncate(const CutSet& cut, QList<Event*>& events);/*vrai si la coupe partielle doit etre abandonnee*/
+    double topProbability(QList<CutSet>& mcs);/*calculer la proba exacte de top avec un BDD*/
 
 
 public :
-	ResultMCS(Gate* top, double missionTime, double step);
+	ResultMCS(Gate* top, double missionTime, double step, int maxOrder = 0, double cutoff = 0, Progress* progress = nullptr);
 	~ResultMCS();
     QList<QList<QString>> getMCS();
+    int getMaxOrder();
+    double getCutoff();
 };
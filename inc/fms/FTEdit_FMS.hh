@@ -1,4 +1,6 @@
 #pragma once
 
 #include "FileManagerSystem.hh"
+#include "Journal.hh"
 #include "SaveVisitor.hh"
+#include "SnapshotFile.hh"
@@ -1,17 +1,19 @@
 #pragma once
 
 #include <QString>
-#include <QMap>
 #include "FTEdit_Editor.hh"
 #include "FTEdit_Evaluator.hh"
+#include "Journal.hh"
 #include "XmlTreeReader.hh"
 
 class FileManagerSystem
 {
 	private:
-		QMap<Tree*, Gate*> treegatemap;
 		QString path;
 		QString errorMessage;
+		Journal* journal; // changes of the file at journalPath not saved yet
+		QString journalPath;
+		Journal* currentJournal();
 	public:
 		FileManagerSystem();
 		~FileManagerSystem();
@@ -19,8 +21,18 @@ class FileManagerSystem
 		QString getErrorMessage();
 		QString getPath();
 		int exportAs(QString path, Result &result);
+		// Writes the results in the CSV format of exportAs
+		void exportTo(QIODevice *device, Result &result);
 		Editor* load(QString path);
 		int save(Editor* editor);
 		int saveAs(QString path, Editor* editor);
 		void setPath(QString path);
+
+		// Unsaved changes of the file at path were left by a previous session
+		bool hasJournal(QString path);
+		// Opens the file at path with its unsaved changes
+		Editor* recover(QString path);
+		// Records the changes not saved yet in the journal of the current file
+		int autosave(Editor* editor);
+		void discardJournal(QString path);
 };
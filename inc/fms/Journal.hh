@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include "FTEdit_Editor.hh"
+
+// Unsaved changes of a model, kept next to its OPSA-MEF file
+// xmlPath + ".autosave" is a snapshot of the model, xmlPath + ".journal" the changes made since
+// Each write appends the records of the objects marked as changed and the names freed since the previous one
+class Journal
+{
+	private:
+		QString xmlPath;
+		QString path;
+		QString basePath;
+		Editor* base; // model of the snapshot, nullptr until the next write rewrites it
+		int nbBatches;
+
+		QByteArray baseHash();
+		void apply(Editor* editor, const QByteArray& batch);
+		bool compact(Editor* editor);
+
+	public:
+		Journal(QString xmlPath);
+		~Journal();
+
+		// Unsaved changes were left by a previous session
+		bool exists();
+		// Returns nullptr if the changes cannot be restored
+		Editor* recover();
+		// Records the changes made since the previous call
+		bool write(Editor* editor);
+		// Removes the files, once the model is saved or its changes discarded
+		void clear();
+};
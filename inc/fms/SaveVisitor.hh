@@ -1,23 +1,23 @@
 #pragma once
 
-#include <QDomDocument>
+#include <QIODevice>
 #include <QString>
+#include <QXmlStreamWriter>
 #include "FTEdit_Editor.hh"
 
 class SaveVisitor : public VisitorDistribution, public VisitorNode
 {
 	private :
-		QDomDocument dom;
-		QDomElement treeElem;
-		void writeTypeDistrib(QDomElement &node, QString type);
-		void writeChildren(QDomElement &node, Gate& gate);
+		QXmlStreamWriter xml;
+		void writeTypeDistrib(QString type);
+		void writeChildren(Gate& gate);
 		void writeGate(Gate& gate, QString type);
-		void writeKeep(QDomElement &propelem, Properties& prop);
+		void writeKeep(Properties& prop);
+		void writeDistrib(Distribution& distrib, QString type);
 	public :
-		SaveVisitor();
+		SaveVisitor(QIODevice* device);
 		~SaveVisitor();
-		void setTreeElem(QDomElement elem);
-		QDomDocument& getDomFile();
+		QXmlStreamWriter& getWriter();
 		void visit( And &andgate );
 		void visit( Or &orgate );
 		void visit( Xor &xorgate );
@@ -29,7 +29,7 @@ class SaveVisitor : public VisitorDistribution, public VisitorNode
 		void visit( Weibull &weibulldistrib );
 		void visit( Container &container );
 		void visit( Event &event );
-		void writeNameLabel(QDomElement &elem, Properties& prop);
+		void writeNameLabel(Properties& prop);
 		
 };
 
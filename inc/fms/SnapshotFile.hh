@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QString>
+#include "FTEdit_Editor.hh"
+
+// Binary copy of a model kept next to its OPSA-MEF file (xmlPath + ".snap" by default)
+// Valid as long as the size and the modification date of the XML file are unchanged
+class SnapshotFile
+{
+	private:
+		QString xmlPath;
+		QString path;
+		Editor* parse(const uchar* data, qint64 size);
+
+	public:
+		SnapshotFile(QString xmlPath, QString path = QString());
+		~SnapshotFile();
+
+		QString getPath();
+		// Returns nullptr if the snapshot is missing, outdated or invalid
+		Editor* read();
+		// Must be called once the XML file is written
+		bool write(Editor* editor);
+};
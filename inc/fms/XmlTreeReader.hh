@@ -1,26 +1,43 @@
 #pragma once
 
-#include <QDomDocument>
-#include <QFile>
+#include <QHash>
+#include <QIODevice>
 #include <QMap>
+#include <QXmlStreamReader>
 #include "FTEdit_Editor.hh"
 
 class XmlTreeReader
 {
 	private:
-		QDomDocument &dom;
+		// Reference to a child of a gate, resolved once the whole file is read
+		struct ChildRef
+		{
+			QString tag;
+			QString name;
+		};
+
+		QXmlStreamReader xml;
 		Editor* e;
-		unsigned nodelistcursor;
+		QList<QList<ChildRef>> gateChilds; // same index as e->getGates()
+		QList<int> treeGateEnds; // end of the gates of each tree in e->getGates()
+		QMap<int, QString> eventDistribMap; // index of the event in e->getEvents()
 		QMap<Transfert*, QString> transtreeMap;
-		int searchDistribution(QList<Distribution*>& distribs, QString name);
-		Gate* readGateParams(QDomElement &elem, QList<QDomNodeList>& lelems);
-		void readGateChilds(Gate *g, QDomNodeList list);
+		// Index des objets lus par nom
+		QHash<QString, Distribution*> distribIndex;
+		QHash<QString, int> eventIndex; // index dans e->getEvents()
+		QHash<QString, int> gateIndex; // index dans e->getGates()
+		QHash<QString, int> treeIndex; // index dans e->getTrees()
+		void declare(const QString& name);
+		void readAttributes(QMap<QString, QString>& attrs);
+		QString readLabel();
+		Gate* readGateParams(QList<ChildRef>& childs);
+		void readGateChilds(Gate *g, QList<ChildRef>& childs, int nbgates);
 
 	public:
-		XmlTreeReader(Editor* e, QDomDocument &d);
+		XmlTreeReader(Editor* e, QIODevice* device);
 		~XmlTreeReader();
 		void read();
-		void readTree(QDomElement &elem);
-		void readDistrib(QDomElement &elem);
-		void readEvent(QDomElement &elem);
+		void readTree();
+		void readDistrib();
+		void readEvent();
 };
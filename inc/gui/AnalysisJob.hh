@@ -0,0 +1,40 @@
+#pragma once
+#include <QtWidgets>
+#include "Result.hh"
+
+// Runs an analysis in its own thread so that the user interface stays responsive
+class AnalysisJob : public QThread
+{
+	Q_OBJECT
+
+public:
+	AnalysisJob(QObject *parent, Gate *top, bool useMCS, bool useBoolean, bool useBDD,
+	double missionTime, double step, int maxOrder, double cutoff);
+	~AnalysisJob();
+
+	// Returns the result once the thread is finished, the caller becomes its owner
+	Result *takeResult();
+
+signals:
+	// Emitted periodically from the user interface thread, total is 0 when unknown
+	void progressChanged(int done, int total);
+
+public slots:
+	void cancel();
+
+protected:
+	void run() override;
+
+private:
+	Gate *top;
+	bool useMCS;
+	bool useBoolean;
+	bool useBDD;
+	double missionTime;
+	double step;
+	int maxOrder;
+	double cutoff;
+	Progress progress; // shared with the analysis thread
+	Result *result;
+	QTimer timer; // polls progress
+};
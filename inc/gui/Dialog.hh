@@ -2,6 +2,7 @@
 #include <QtWidgets>
 #include "FTEdit_Editor.hh"
 #include "FTEdit_Evaluator.hh"
+#include "AnalysisJob.hh"
 #include "WidgetLinker.hh"
 
 // Choose a new distribution dialog
@@ -67,8 +68,13 @@ private:
 	QList<Result*> &results;
 	QCheckBox *useBoolean;
 	QCheckBox *useMCS;
+	QCheckBox *useBDD;
 	DoubleSpinBox *missionTime;
 	DoubleSpinBox *step;
+	QSpinBox *maxOrder; // MCS truncation
+	DoubleSpinBox *cutoff;
+	QPushButton *continueButton;
+	bool running; // an analysis is in progress
 
 private slots:
 	void confirm();
@@ -78,6 +84,9 @@ private slots:
 public:
 	// Stores Result in results list
 	ChooseResultDialog(QWidget *parent, Gate *top, QList<Result*> &list);
+
+	// Ignored while an analysis is in progress (Esc, close button)
+	void reject() override;
 };
 
 // Choose a new fault tree from list, store the index in treeIndex
@@ -1,5 +1,6 @@
 #pragma once
 #include <QMainWindow>
+#include <QTimer>
 #include "FTEdit_Evaluator.hh"
 #include "FTEdit_FMS.hh"
 #include "WidgetLinker.hh"
@@ -7,9 +8,11 @@
 #define ICON_SIZE	48
 #define RES_MIN_X	460
 #define RES_MIN_Y	320
+#define AUTOSAVE_INTERVAL	30000 // ms
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 
 class NodeItem;
+class RenderVisitor;
 
 class MainWindow : public QMainWindow
 {
@@ -27,6 +30,7 @@ private slots:
 	void open();
 	void save();
 	void saveAs();
+	void autosave();
 	// Edit
 	void cut();
 	void copy();
@@ -49,6 +53,7 @@ private slots:
 	void detach();
 	void join();
 	void newTransfert();
+	void collapse();
 	// View
 	void zoomIn();
 	void zoomOut();
@@ -82,7 +87,9 @@ private:
 	Editor				*editor;
 	FileManagerSystem	*fileManager;
 	bool				modified;
+	QTimer				*autosaveTimer;
 	NodeItem			*curItem;
+	RenderVisitor		*renderer;
 	QList<Result*>		resultsHistory;
 	int					curTreeRow;
 	int					selectedRow;
@@ -113,6 +120,7 @@ private:
 		QAction *detachItemAct;
 		QAction *joinItemAct;
 		QAction *newTransfertAct;
+		QAction *collapseItemAct;
 	QAction *zoomInAct;
 	QAction *zoomOutAct;
 	QAction *zoomResetAct;
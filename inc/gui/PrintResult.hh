@@ -17,7 +17,11 @@ private:
 	QString date;
 	QTableWidget *prb;
 	QTableWidget *mcs;
+	QTableWidget *bdd;
 
-	void initBoolean(ResultBoolean *res);
+	// Fill a table with the probabilities of an analysis over the mission time
+	void initProbabilities(QTableWidget *table, Evaluator *res);
 	void initMCS(ResultMCS *res);
+	// Add a tab containing a time/probability table
+	QTableWidget *addProbabilitiesTab(QTabWidget *tabs, const QString &title, const QString &header);
 };
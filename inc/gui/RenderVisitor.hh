@@ -3,6 +3,8 @@
 #include "MainWindow.hh"
 #include "WidgetLinker.hh"
 
+#define LOD_TEXT	0.3 // Below this scale cards are drawn as plain boxes
+
 // Qt graphic item (Node has to be converted)
 class NodeItem : public QGraphicsRectItem
 {
@@ -12,6 +14,9 @@ private:
 	Node *n;
 	Properties *prop;
 	bool child;
+	QPoint origin; // Position of n when the item was last placed
+	QStaticText name; // Text layouts, rebuilt when the properties change
+	QStaticText desc;
 
 	void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
 	void contextMenuEvent(QGraphicsSceneContextMenuEvent *event) override;
@@ -24,21 +29,45 @@ public:
 	// GetNode
 	Node *node();
 
+	Properties *properties();
+
 	void setProperties(Properties *prop);
 
-	QRectF boundingRect() const override;
+	// Same kind of node (the icon is shared by every item of a kind)
+	bool hasIcon(const QPixmap &icon);
+
+	// Follows the position of the node, returns false if it did not move
+	bool updatePosition();
 
 	void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
 };
 
+// Keeps the items of the displayed tree between two renderings
 class RenderVisitor : public VisitorNode
 {
 private:
 	MainWindow &win;
 	Node *selection;
+	QHash<Node*, NodeItem*> items;
+	QHash<Node*, QGraphicsPathItem*> links; // Connectors drawn under each gate, one item per gate
+	QSet<Node*> visited;
+
+	void visitChildren(Gate &gate);
+
+	void setLinks(Node *node, const QPainterPath &path);
+
+	void setItem(Node &node, const QPixmap &icon, Properties *prop, bool isChild = false);
 
 public:
-	RenderVisitor(MainWindow &win, Node *selection);
+	RenderVisitor(MainWindow &win);
+
+	// Only creates, removes or moves the items of the nodes changed since the previous call
+	void render(Node *top, Node *selection);
+
+	// Forgets every item, to be called once the scene is cleared
+	void clear();
+
+	NodeItem *item(Node *node);
 
 	void visit(And &gate);
 
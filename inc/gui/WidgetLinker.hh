@@ -7,6 +7,11 @@ class DoubleSpinBox : public QDoubleSpinBox
 
 private:
 	QString textFromValue(double d) const;
+	// Text of the number without the prefix and the suffix
+	QString stripped(const QString &text) const;
+	// Accepts the scientific notation used by textFromValue
+	double valueFromText(const QString &text) const;
+	QValidator::State validate(QString &text, int &pos) const;
 
 public:
 	DoubleSpinBox(QWidget *parent = nullptr);
@@ -1,16 +1,30 @@
 #!/bin/bash
 
 if [[ "$#" -eq 1 && ("$1" == "--clean" || "$1" == "--rebuild") ]]; then
-	rm -rf .build release Makefile .qmake.stash
+	rm -rf .build release Makefile Makefile.cli Makefile.bench .qmake.stash
 	if [ "$1" == "--clean" ]; then
 		exit
 	fi
+elif [[ "$#" -eq 1 && "$1" == "--cli" ]]; then
+	if [[ ! -f "Makefile.cli" ]]; then
+		qmake Cli.pro -o Makefile.cli
+	fi
+	make -f Makefile.cli
+	exit
+elif [[ "$#" -eq 1 && "$1" == "--bench" ]]; then
+	if [[ ! -f "Makefile.bench" ]]; then
+		qmake Bench.pro -o Makefile.bench
+	fi
+	make -f Makefile.bench
+	exit
 elif [[ "$#" -gt 0 ]]; then
 	echo "error: unrecognized argument"
 	echo "usage: bash $0"
 	printf "Autocompilation script\n\n"
 	echo "  --clean    Remove compilation build (Makefile included)"
 	echo "  --rebuild  Force target rebuild"
+	echo "  --cli      Build the command line analysis runner"
+	echo "  --bench    Build the benchmark suite"
 	exit
 fi
 if [[ ! -f "Makefile" ]]; then
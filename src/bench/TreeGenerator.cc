@@ -0,0 +1,123 @@
+#include "TreeGenerator.hh"
+
+TreeGenerator::TreeGenerator(Editor &editor, const TreeShape &shape) :
+editor(editor), shape(shape), rng(shape.seed), nbGates(0), nbLeaves(0)
+{}
+
+TreeGenerator::~TreeGenerator()
+{}
+
+QString TreeGenerator::newName(const QString &prefix)
+{
+	QString name = editor.generateName(prefix);
+	editor.addName(name);
+	return (name);
+}
+
+Gate *TreeGenerator::newGate()
+{
+	int total = shape.andWeight + shape.orWeight + shape.xorWeight + shape.votingWeight + shape.inhibitWeight;
+	int r = std::uniform_int_distribution<int>(0, qMax(total, 1) - 1)(rng);
+	Gate *g;
+	if ((r -= shape.andWeight) < 0 || total <= 0)
+		g = new And(newName("And"));
+	else if ((r -= shape.orWeight) < 0)
+		g = new Or(newName("Or"));
+	else if ((r -= shape.xorWeight) < 0)
+		g = new Xor(newName("Xor"));
+	else if ((r -= shape.votingWeight) < 0)
+		g = new VotingOR(newName("KN"));
+	else
+	{
+		auto inhibit = new Inhibit(newName("Inhibit"));
+		inhibit->setCondition(true);
+		g = inhibit;
+	}
+	editor.getGates() << g;
+	++nbGates;
+	return (g);
+}
+
+Node *TreeGenerator::newLeaf()
+{
+	QList<Event> &events = editor.getEvents();
+	++nbLeaves;
+	if (events.size() && std::bernoulli_distribution(shape.sharedRatio)(rng))
+		return (new Container(&events[std::uniform_int_distribution<int>(0, events.size() - 1)(rng)]));
+	Distribution *d;
+	switch (std::uniform_int_distribution<int>(0, 2)(rng))
+	{
+		case 0:
+			d = new Constant(newName("Constant"));
+			d->setValue(std::uniform_real_distribution<double>(1e-4, 0.1)(rng));
+			break ;
+		case 1:
+		{
+			auto exp = new Exponential(newName("Exponential"));
+			exp->setLambda(std::uniform_real_distribution<double>(1e-6, 1e-3)(rng));
+			d = exp;
+			break ;
+		}
+		default:
+		{
+			auto weibull = new Weibull(newName("Weibull"));
+			weibull->setScale(std::uniform_real_distribution<double>(1e3, 1e5)(rng));
+			weibull->setShape(std::uniform_real_distribution<double>(0.5, 3)(rng));
+			d = weibull;
+		}
+	}
+	editor.getDistributions() << d;
+	events << Event(newName("Event"));
+	events.last().setDistribution(d);
+	return (new Container(&events.last()));
+}
+
+// The first leaf reached is replaced by a transfer to link
+Gate *TreeGenerator::generate(int depth, Tree *link, bool &linked)
+{
+	Gate *g = newGate();
+	int n = dynamic_cast<Inhibit*>(g) ? 1 : dynamic_cast<Xor*>(g) ? 2 : qMax(shape.fanOut, 2);
+	for (int i = 0; i < n; ++i)
+	{
+		Node *child;
+		if (depth > 0)
+			child = generate(depth - 1, link, linked);
+		else if (link && !linked)
+		{
+			auto transfert = new Transfert();
+			transfert->setLink(link);
+			linked = true;
+			child = transfert;
+		}
+		else
+			child = newLeaf();
+		child->attach(g);
+	}
+	if (auto voting = dynamic_cast<VotingOR*>(g))
+		voting->setK(qBound(1, shape.votingK, n));
+	return (g);
+}
+
+Gate *TreeGenerator::generate()
+{
+	Tree *link = nullptr;
+	for (int i = shape.transferts; i >= 0; --i) // the last tree of the chain first
+	{
+		editor.getTrees() << Tree(newName("Tree"));
+		Tree *tree = &editor.getTrees().last();
+		bool linked = false;
+		tree->setTop(generate(shape.depth, link, linked));
+		link = tree;
+	}
+	return (link->getTop());
+}
+
+int TreeGenerator::getNbGates() const
+{
+	return (nbGates);
+}
+
+int TreeGenerator::getNbLeaves() const
+{
+	return (nbLeaves);
+}
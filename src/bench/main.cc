@@ -0,0 +1,144 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include "FTEdit_Editor.hh"
+#include "FTEdit_Evaluator.hh"
+#include "FTEdit_FMS.hh"
+#include "TreeGenerator.hh"
+
+// Throughput of the evaluator and of the file manager on synthetic fault trees
+// One CSV line per measure, times are in seconds
+
+struct Scenario
+{
+	QString		name;
+	TreeShape	shape;
+	bool		mcs; // the number of cut sets grows too fast on the largest trees
+};
+
+static QList<Scenario> scenarios(bool quick)
+{
+	QList<Scenario> list;
+	int maxDepth = quick ? 4 : 7;
+	for (int depth = 2; depth <= maxDepth; ++depth)
+	{
+		Scenario s{"mixed", TreeShape(), depth <= 4};
+		s.shape.depth = depth;
+		s.shape.transferts = 2;
+		list << s;
+		s.name = "xor";
+		s.shape.xorWeight = 2;
+		s.mcs = false; // MCS ignores the negations of Xor
+		list << s;
+		s = Scenario{"voting", TreeShape(), depth <= 3};
+		s.shape.depth = depth;
+		s.shape.fanOut = 5;
+		s.shape.votingWeight = 4;
+		s.shape.votingK = 3;
+		list << s;
+		s = Scenario{"shared", TreeShape(), depth <= 4};
+		s.shape.depth = depth;
+		s.shape.sharedRatio = 0.8;
+		list << s;
+	}
+	return (list);
+}
+
+class Bench
+{
+private:
+	QTextStream	&out;
+	int			repeats;
+
+public:
+	Bench(QTextStream &out, int repeats) : out(out), repeats(repeats)
+	{
+		out << "scenario,depth,gates,leaves,operation,repeats,best,mean\n";
+	}
+
+	template<typename F>
+	void measure(const Scenario &s, const TreeGenerator &gen, const QString &operation, F f)
+	{
+		double best = 0, total = 0;
+		QElapsedTimer timer;
+		for (int i = 0; i < repeats; ++i)
+		{
+			timer.start();
+			f();
+			double t = timer.nsecsElapsed() * 1e-9;
+			best = i ? qMin(best, t) : t;
+			total += t;
+		}
+		out << s.name << ',' << s.shape.depth << ',' << gen.getNbGates() << ',' << gen.getNbLeaves() << ','
+		<< operation << ',' << repeats << ',' << doubleToString(best) << ',' << doubleToString(total / repeats) << '\n';
+		out.flush();
+	}
+};
+
+int main(int argc, char **argv)
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("ftedit-bench");
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Benchmarks the analyses and the file manager on synthetic fault trees");
+	parser.addHelpOption();
+	parser.addOptions({
+		{"quick", "Only run the smallest trees."},
+		{"repeat", "Run every measure <n> times (default: 5).", "n", "5"},
+		{{"o", "output"}, "Write the results to <csv> instead of the standard output.", "csv"}
+	});
+	parser.process(app);
+
+	int repeats = qMax(1, parser.value("repeat").toInt());
+	QFile file;
+	if (parser.isSet("output"))
+	{
+		file.setFileName(parser.value("output"));
+		if (!file.open(QIODevice::WriteOnly))
+		{
+			QTextStream(stderr) << "ftedit-bench: " << file.fileName() << ": " << file.errorString() << '\n';
+			return (1);
+		}
+	}
+	else
+		file.open(stdout, QIODevice::WriteOnly);
+	QTextStream out(&file);
+	Bench bench(out, repeats);
+	QString path = QDir::temp().filePath("ftedit-bench.xml");
+
+	for (const Scenario &s : scenarios(parser.isSet("quick")))
+	{
+		Editor editor(false);
+		TreeGenerator gen(editor, s.shape);
+		Gate *top = gen.generate();
+		FileManagerSystem fms;
+
+		bench.measure(s, gen, "boolean", [top]() { ResultBoolean res(top, 1000, 1); });
+		bench.measure(s, gen, "bdd", [top]() { ResultBDD res(top, 1000, 1); });
+		if (s.mcs)
+			bench.measure(s, gen, "mcs", [top]() { ResultMCS res(top, 1000, 1); });
+		bench.measure(s, gen, "save", [&fms, &editor, &path]() { fms.saveAs(path, &editor); });
+		// load parses the XML file (and writes its snapshot), reopen reads the snapshot
+		bench.measure(s, gen, "load", [&fms, &path]() { QFile::remove(SnapshotFile(path).getPath()); delete fms.load(path); });
+		bench.measure(s, gen, "reopen", [&fms, &path]() { delete fms.load(path); });
+		// layout places the whole tree, relayout only the path of one changed gate
+		bench.measure(s, gen, "layout", [&editor, top]() {
+			for (Gate *g : editor.getGates())
+				g->invalidateLayout();
+			top->balanceNodePos();
+		});
+		Gate *edited = editor.getGates().last();
+		bench.measure(s, gen, "relayout", [edited, top]() { edited->invalidateLayout(); top->balanceNodePos(); });
+		// autosave appends one changed gate to the journal, the first call only writes its snapshot
+		fms.autosave(&editor);
+		bench.measure(s, gen, "autosave", [&fms, &editor, edited]() {
+			edited->getProperties().setDesc(edited->getProperties().getDesc() + '.');
+			fms.autosave(&editor);
+		});
+		fms.discardJournal(path);
+	}
+	QFile::remove(path);
+	QFile::remove(SnapshotFile(path).getPath());
+	return (0);
+}
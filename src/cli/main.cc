@@ -0,0 +1,99 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include "FTEdit_Editor.hh"
+#include "FTEdit_Evaluator.hh"
+#include "FTEdit_FMS.hh"
+
+// Headless analysis of an OPSA-MEF file, the results are written in the CSV format of the editor
+
+static int error(const QString &message, int code = 1)
+{
+	QTextStream(stderr) << "ftedit-cli: " << message << '\n';
+	return (code);
+}
+
+// Returns the tree named name, or the selected (first) tree if name is empty
+static Tree *findTree(Editor &editor, const QString &name)
+{
+	if (name.isEmpty())
+		return (editor.getSelection() ? editor.getSelection()
+		: editor.getTrees().size() ? &editor.getTrees().first() : nullptr);
+	for (Tree &t : editor.getTrees())
+		if (t.getProperties().getName() == name)
+			return (&t);
+	return (nullptr);
+}
+
+int main(int argc, char **argv)
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("ftedit-cli");
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Performs a fault tree analysis without the graphical interface");
+	parser.addHelpOption();
+	parser.addPositionalArgument("file", "OPSA-MEF file to load");
+	parser.addOptions({
+		{{"o", "output"}, "Write the results to <csv> instead of the standard output.", "csv"},
+		{{"t", "tree"}, "Analyse the tree <name> (default: the selected tree).", "name"},
+		{{"b", "boolean"}, "Use boolean algebra."},
+		{{"m", "mcs"}, "Find the minimal cut sets."},
+		{{"d", "bdd"}, "Use a binary decision diagram."},
+		{"mission-time", "Maximum operating time (default: 0).", "time", "0"},
+		{"step", "Time between each calculation (default: 0).", "step", "0"},
+		{"max-order", "Discard the cut sets with more than <order> events.", "order", "0"},
+		{"cutoff", "Discard the cut sets less likely than <probability>.", "probability", "0"}
+	});
+	parser.process(app);
+
+	if (parser.positionalArguments().size() != 1)
+		return (error("expected exactly one input file, see --help"));
+	bool ok[4];
+	double missionTime = parser.value("mission-time").toDouble(&ok[0]);
+	double step = parser.value("step").toDouble(&ok[1]);
+	int maxOrder = parser.value("max-order").toInt(&ok[2]);
+	double cutoff = parser.value("cutoff").toDouble(&ok[3]);
+	if (!ok[0] || !ok[1] || !ok[2] || !ok[3] || missionTime < 0 || step < 0 || maxOrder < 0 || cutoff < 0 || cutoff > 1)
+		return (error("invalid numeric option"));
+	bool useBoolean = parser.isSet("boolean"), useMCS = parser.isSet("mcs"), useBDD = parser.isSet("bdd");
+	if (!useBoolean && !useMCS && !useBDD)
+	{
+		error("no analysis selected: use --boolean, --mcs or --bdd");
+		parser.showHelp(1);
+	}
+	if ((useBoolean || useBDD) && missionTime > 0.0)
+	{
+		if (step == 0.0)
+			return (error("the step must be positive"));
+		if (missionTime / step > 1e6)
+			return (error("limit exceeded"));
+	}
+
+	FileManagerSystem fms;
+	Editor *editor = fms.load(parser.positionalArguments().first());
+	if (!editor)
+		return (error(parser.positionalArguments().first() + ": " + fms.getErrorMessage()));
+	Tree *tree = findTree(*editor, parser.value("tree"));
+	if (!tree || !tree->getTop())
+	{
+		delete editor;
+		return (error(parser.isSet("tree") ? "no tree named " + parser.value("tree") : QString("the file has no tree")));
+	}
+	Result result(tree->getTop(), useMCS, useBoolean, useBDD, missionTime, step, maxOrder, cutoff);
+	int code = 0;
+	for (const QString &e : result.getErrors()) // invalid tree
+		code = error(e, 2);
+	if (!code && parser.isSet("output"))
+	{
+		if (fms.exportAs(parser.value("output"), result))
+			code = error(parser.value("output") + ": " + fms.getErrorMessage());
+	}
+	else if (!code)
+	{
+		QFile out;
+		out.open(stdout, QIODevice::WriteOnly);
+		fms.exportTo(&out, result);
+	}
+	delete editor;
+	return (code);
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "Distribution.hh"
 #include "VisitorDistribution.hh"
 
@@ -14,6 +15,12 @@ double Constant::getProbability(double time)
 	return (value);
 }
 
+void Constant::getProbabilities(const double *times, double *out, int n)
+{
+	(void)times;
+	std::fill(out, out + n, value);
+}
+
 void Constant::accept(VisitorDistribution& visitor)
 {
 	visitor.visit(*this);
@@ -27,6 +27,8 @@ void Container::setEvent(Event* event)
 	this->event = event;
 	if(this->event)//incrémente si event non null
 		this->event->getProperties().incrementRefCount();
+	if(parent)
+		parent->getProperties().setChanged();
 }
 
 Event* Container::getEvent() const
@@ -20,6 +20,7 @@ double Distribution::getValue()
 void Distribution::setValue(double value)
 {
 	this->value = qBound(0.0, value, 1.0);
+	prop.setChanged();
 }
 
 
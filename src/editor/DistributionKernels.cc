@@ -0,0 +1,127 @@
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include "DistributionKernels.hh"
+
+// Branch free exp() and log() so that the loops calling them can be vectorized
+// exp() is accurate to 1 ulp, pow() built on top of them loses a few more digits for large shapes (1e-13 at worst)
+
+#define LN2_HI		6.93147180369123816490e-01 // k * LN2_HI is exact for |k| < 2^11
+#define LN2_LO		1.90821492927058770002e-10
+#define LOG2E		1.44269504088896338700e+00
+#define ROUNDER		6755399441055744.0 // 1.5 * 2^52, rounds to the nearest integer
+
+static inline quint64 toBits(double d)
+{
+	quint64 u;
+	memcpy(&u, &d, sizeof(u));
+	return (u);
+}
+
+static inline double fromBits(quint64 u)
+{
+	double d;
+	memcpy(&d, &u, sizeof(d));
+	return (d);
+}
+
+// e^x = s * (1 + q) with s = 2^k and |log(1 + q)| <= ln(2) / 2
+static inline double expParts(double x, double &q)
+{
+	x = x > 710.0 ? 710.0 : x; // overflows or underflows anyway
+	x = x < -746.0 ? -746.0 : x;
+	double k = (x * LOG2E + ROUNDER) - ROUNDER;
+	double r = (x - k * LN2_HI) - k * LN2_LO;
+	// Taylor series of e^r - 1 up to r^13
+	double p = 1.0 / 6227020800.0;
+	p = p * r + 1.0 / 479001600.0;
+	p = p * r + 1.0 / 39916800.0;
+	p = p * r + 1.0 / 3628800.0;
+	p = p * r + 1.0 / 362880.0;
+	p = p * r + 1.0 / 40320.0;
+	p = p * r + 1.0 / 5040.0;
+	p = p * r + 1.0 / 720.0;
+	p = p * r + 1.0 / 120.0;
+	p = p * r + 1.0 / 24.0;
+	p = p * r + 1.0 / 6.0;
+	p = p * r + 0.5;
+	q = r + r * r * p;
+	// 2^k = 2^k1 * 2^k2 so that both factors are normal numbers, the product rounds to 0 or inf by itself
+	double k1 = (k * 0.5 + ROUNDER) - ROUNDER;
+	double k2 = k - k1;
+	double s = fromBits((toBits(k1 + ROUNDER) + 1023) << 52); // the low bits of k + ROUNDER hold k
+	return (s * fromBits((toBits(k2 + ROUNDER) + 1023) << 52));
+}
+
+static inline double expKernel(double x)
+{
+	double q, s = expParts(x, q);
+	return (s * q + s);
+}
+
+// e^x - 1 without cancellation when x is close to 0
+static inline double expm1Kernel(double x)
+{
+	double q, s = expParts(x, q);
+	return (s * q + (s - 1.0));
+}
+
+// x must be a positive normal number
+static inline double logKernel(double x)
+{
+	quint64 u = toBits(x);
+	// x = 2^e * m with m in [sqrt(2) / 2, sqrt(2)]
+	quint64 big = (u & 0x000fffffffffffffULL) > 0x6a09e667f3bcdULL; // mantissa of sqrt(2)
+	double e = fromBits(0x4330000000000000ULL | ((u >> 52) + big)) - (4503599627370496.0 + 1023.0);
+	double m = fromBits((u & 0x000fffffffffffffULL) | (0x3ff0000000000000ULL - (big << 52)));
+	// log(m) = 2 * atanh(s)
+	double s = (m - 1.0) / (m + 1.0);
+	double s2 = s * s;
+	double p = 1.0 / 23.0;
+	p = p * s2 + 1.0 / 21.0;
+	p = p * s2 + 1.0 / 19.0;
+	p = p * s2 + 1.0 / 17.0;
+	p = p * s2 + 1.0 / 15.0;
+	p = p * s2 + 1.0 / 13.0;
+	p = p * s2 + 1.0 / 11.0;
+	p = p * s2 + 1.0 / 9.0;
+	p = p * s2 + 1.0 / 7.0;
+	p = p * s2 + 1.0 / 5.0;
+	p = p * s2 + 1.0 / 3.0;
+	double lm = 2.0 * s + 2.0 * s * s2 * p;
+	return (e * LN2_HI + (lm + e * LN2_LO));
+}
+
+FTEDIT_KERNEL
+void exponentialKernel(double lambda, const double *times, double *out, int n)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = -expm1Kernel(-lambda * times[i]);
+}
+
+FTEDIT_KERNEL
+void weibullKernel(double scale, double shape, const double *times, double *out, int n)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = -expm1Kernel(-expKernel(shape * logKernel(times[i] / scale)));
+	// t = 0, scale = 0... are left to the C library
+	for (int i = 0; i < n; ++i)
+	{
+		double u = times[i] / scale;
+		if (!(u >= DBL_MIN && u <= DBL_MAX))
+			out[i] = -expm1(-pow(u, shape));
+	}
+}
+
+FTEDIT_KERNEL
+void weibullEventsKernel(double time, const double *scales, const double *shapes, double *out, int n)
+{
+	for (int i = 0; i < n; ++i)
+		out[i] = -expm1Kernel(-expKernel(shapes[i] * logKernel(time / scales[i])));
+	for (int i = 0; i < n; ++i)
+	{
+		double u = time / scales[i];
+		if (!(u >= DBL_MIN && u <= DBL_MAX))
+			out[i] = -expm1(-pow(u, shapes[i]));
+	}
+}
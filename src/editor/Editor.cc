@@ -2,7 +2,9 @@
 #include <limits>
 #include "Editor.hh"
 #include "ClipVisitor.hh"
+#include "Container.hh"
 #include "PasteVisitor.hh"
+#include "Transfert.hh"
 
 Editor::Editor(bool autoRefresh) : clipboard(nullptr), selection(nullptr), autoRefresh(autoRefresh)
 {}
@@ -23,6 +25,10 @@ Editor::~Editor()
 	
 	if(clipboard)
 		delete clipboard;
+	// Références prises par addName()
+	for (auto it = names.constBegin(); it != names.constEnd(); ++it)
+		for (int i = 0; i < it.value(); ++i)
+			NamePool::release(it.key());
 }
 
 QList<Tree> &Editor::getTrees()
@@ -55,6 +61,11 @@ Tree *Editor::getSelection()
 	return (selection);
 }
 
+const QSet<QString> &Editor::getFreedNames()
+{
+	return (freedNames);
+}
+
 void Editor::setSelection(Tree *selection)
 {
 	this->selection = selection;
@@ -65,6 +76,11 @@ void Editor::setAutoRefresh(bool value)
 	autoRefresh = value;
 }
 
+void Editor::clearFreedNames()
+{
+	freedNames.clear();
+}
+
 void Editor::copy(Node *top)
 {
 	resetClipboard();
@@ -110,6 +126,7 @@ void Editor::remove(Node *top)
 void Editor::detach(Gate *top)
 {
 	trees.push_back(Tree(generateName(PREFIX_TREE)));
+	addName(trees.last().getProperties().getName());
 	trees.last().setTop(top);
 	if (selection && top == selection->getTop())
 		selection->setTop(nullptr);
@@ -132,27 +149,66 @@ QString Editor::generateName(QString prefix)
 {
 	QString	s;
 
-	for (uint i = 1; i < std::numeric_limits<uint>::max(); ++i)
+	// Le compteur n'avance que si le nom est pris: un nom généré mais inutilisé sera proposé à nouveau
+	for (uint i = counters.value(prefix, 1); i < std::numeric_limits<uint>::max(); ++i)
 		if (isUnique(s = prefix + QString::number(i)))
+		{
+			counters.insert(prefix, i);
 			return (s);
+		}
 	return (s = "");
 }
 
 bool Editor::isUnique(QString name)
 {
-	for (int i = 0; i < trees.size(); ++i)
-		if (trees[i].getProperties().getName() == name)
-			return (false);
-	for (int i = 0; i < events.size(); ++i)
-		if (events[i].getProperties().getName() == name)
-			return (false);
-	for (int i = 0; i < distributions.size(); ++i)
-		if (distributions[i]->getProperties().getName() == name)
-			return (false);
-	for (int i = 0; i < gates.size(); ++i)
-		if (gates[i]->getProperties().getName() == name)
-			return (false);
-	return (true);
+	int id = NamePool::find(name);
+	return (id == -1 || !names.contains(id));
+}
+
+void Editor::addName(QString name)
+{
+	++names[NamePool::intern(name)];
+}
+
+void Editor::removeName(QString name)
+{
+	int id = NamePool::find(name);
+	auto it = names.find(id);
+	if (it == names.end())
+		return ;
+	NamePool::release(id); // référence prise par addName()
+	if (!--it.value())
+	{
+		names.erase(it);
+		freedNames.insert(name);
+	}
+}
+
+void Editor::rename(Properties &prop, QString name)
+{
+	if (name == prop.getName())
+		return ;
+	removeName(prop.getName());
+	prop.setName(name);
+	addName(name);
+	// Les objets sont enregistrés avec les noms de ceux qu'ils désignent
+	for (Gate *g : gates)
+		for (Node *n : g->getChildren())
+		{
+			Gate *child = dynamic_cast<Gate*>(n);
+			Container *c = dynamic_cast<Container*>(n);
+			Transfert *t = dynamic_cast<Transfert*>(n);
+			if ((child && &child->getProperties() == &prop)
+			|| (c && c->getEvent() && &c->getEvent()->getProperties() == &prop)
+			|| (t && t->getLink() && &t->getLink()->getProperties() == &prop))
+				g->getProperties().setChanged();
+		}
+	for (Tree &t : trees)
+		if (t.getTop() && &t.getTop()->getProperties() == &prop)
+			t.getProperties().setChanged();
+	for (Event &e : events)
+		if (e.getDistribution() && &e.getDistribution()->getProperties() == &prop)
+			e.getProperties().setChanged();
 }
 
 void Editor::refresh()
@@ -161,19 +217,27 @@ void Editor::refresh()
 		return ;
 	for (int i = 0; i < trees.size(); ++i)
 		if (trees[i].getProperties().canBeRemoved())
+		{
+			removeName(trees[i].getProperties().getName());
 			trees.removeAt(i--);
+		}
 	for (int i = 0; i < events.size(); ++i)
 		if (events[i].getProperties().canBeRemoved())
+		{
+			removeName(events[i].getProperties().getName());
 			events.removeAt(i--);
+		}
 	for (int i = 0; i < distributions.size(); ++i)
 		if (distributions[i]->getProperties().canBeRemoved())
 		{
+			removeName(distributions[i]->getProperties().getName());
 			delete distributions[i];
 			distributions.removeAt(i--);
 		}
 	for (int i = 0; i < gates.size(); ++i)
 		if (gates[i]->getProperties().canBeRemoved() && !gates[i]->getParent())
 		{
+			removeName(gates[i]->getProperties().getName());
 			delete gates[i];
 			gates.removeAt(i--);
 		}
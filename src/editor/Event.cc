@@ -13,6 +13,7 @@ void Event::setDistribution(Distribution *distribution)
 	this->distribution = distribution;
 	if(this->distribution)//increment if distribution not null
 		this->distribution->getProperties().incrementRefCount();
+	prop.setChanged();
 }
 
 Distribution* Event::getDistribution()
@@ -32,7 +33,7 @@ void Event::accept(SaveVisitor& v)
 
 bool Event::operator==(const Event& e1) const
 {
-	return prop.getName()  == e1.prop.getName();
+	return prop.getNameId() == e1.prop.getNameId();
 }
 
 bool Event::operator <(const Event& e1) const
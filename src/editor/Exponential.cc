@@ -2,6 +2,7 @@
 #include <limits>
 #include <QtGlobal>
 #include "Distribution.hh"
+#include "DistributionKernels.hh"
 #include "VisitorDistribution.hh"
 
 Exponential::Exponential(QString name) : Distribution(name)
@@ -17,12 +18,18 @@ double Exponential::getLambda()
 
 double Exponential::getProbability(double time)
 {
-	return (1 - exp(-value * time));
+	return (-expm1(-value * time)); // 1 - exp(-value * time) without cancellation
+}
+
+void Exponential::getProbabilities(const double *times, double *out, int n)
+{
+	exponentialKernel(value, times, out, n);
 }
 
 void Exponential::setLambda(double lambda)
 {
 	value = qBound(0.0,lambda,std::numeric_limits<double>::max());
+	prop.setChanged();
 }
 
 void Exponential::accept(VisitorDistribution& visitor)
@@ -1,6 +1,8 @@
+#include <climits>
 #include "Gate.hh"
 
-Gate::Gate(QString name,bool keep) :Node(),prop(name, keep)
+Gate::Gate(QString name,bool keep) :Node(),prop(name, keep), collapsed(false), dirty(true), placed(false),
+contourLeft(1, 0), contourRight(1, 0)
 {}
 
 Gate::~Gate()
@@ -27,39 +29,100 @@ Node* Gate::search(QPoint around)
 	return (n);
 }
 
-static void first_pass(Node *n, int i, QVector<int> &maxX)
+void Gate::invalidateLayout()
 {
-	QPoint p;
-	if (n->getParent())
-		p.setY(n->getParent()->getPosition().y() + CARD_Y + CARD_GAP_Y);
-	Gate *g = dynamic_cast<Gate*>(n);
-	if (g && g->getChildren().size())
-	{
-		if (n->getParent() && maxX[i - 1] > maxX[i])
-			maxX[i] = maxX[i - 1];
-		p.setX(maxX[i]);
-		n->setPosition(p);
-		int x = 0;
-		for (int j = 0; j < g->getChildren().size(); ++j, x += CARD_X)
-			first_pass(g->getChildren()[j], i + 1, maxX);
-		x = g->getChildren().last()->getPosition().x() - g->getChildren().first()->getPosition().x();
-		maxX[i] = g->getChildren().first()->getPosition().x() + x / 2;
-		p.setX(maxX[i]);
-		n->setPosition(p);
-		maxX[i] += CARD_X;
+	prop.setChanged(); // la liste des fils est enregistrée avec la porte
+	// Les ancêtres d'une porte à recalculer le sont aussi
+	for (Gate *g = this; g && !g->dirty; g = g->getParent())
+		g->dirty = true;
+}
+
+bool Gate::isCollapsed()
+{
+	return (collapsed);
+}
+
+void Gate::setCollapsed(bool collapsed)
+{
+	if (this->collapsed == collapsed)
 		return ;
+	this->collapsed = collapsed;
+	invalidateLayout();
+}
+
+// Reingold-Tilford: chaque sous-arbre est poussé à gauche contre les contours des précédents
+// et la porte est centrée sur ses fils, seuls les sous-arbres modifiés sont recalculés
+void Gate::layout()
+{
+	if (!dirty)
+		return ;
+	QVector<int> left, right; // contours des fils déjà placés, par profondeur
+	int n = collapsed ? 0 : children.size(); // les fils cachés ne prennent pas de place
+	QVector<int> x(n);
+	for (int i = 0; i < n; ++i)
+	{
+		Gate *g = dynamic_cast<Gate*>(children[i]);
+		if (g)
+			g->layout();
+		static const QVector<int> leaf(1, 0);
+		const QVector<int> &cl = g ? g->contourLeft : leaf;
+		const QVector<int> &cr = g ? g->contourRight : leaf;
+		if (i)
+		{
+			x[i] = INT_MIN;
+			for (int d = 0; d < cl.size() && d < right.size(); ++d)
+				x[i] = qMax(x[i], right[d] + int(CARD_X) - cl[d]);
+		}
+		for (int d = 0; d < cl.size(); ++d)
+		{
+			if (d < right.size())
+				right[d] = x[i] + cr[d];
+			else
+			{
+				left << x[i] + cl[d];
+				right << x[i] + cr[d];
+			}
+		}
+	}
+	int center = n ? (x.first() + x.last()) / 2 : 0;
+	offsets.resize(n);
+	for (int i = 0; i < n; ++i)
+		offsets[i] = x[i] - center;
+	contourLeft.fill(0, 1);
+	contourRight.fill(0, 1);
+	for (int d = 0; d < left.size(); ++d)
+	{
+		contourLeft << left[d] - center;
+		contourRight << right[d] - center;
+	}
+	dirty = false;
+	placed = false;
+}
+
+void Gate::place(QPoint position)
+{
+	if (placed && position == this->position)
+		return ; // le sous-arbre n'a pas bougé
+	this->position = position;
+	for (int i = 0; i < offsets.size(); ++i)
+	{
+		QPoint p(position.x() + offsets[i], position.y() + CARD_Y + CARD_GAP_Y);
+		Gate *g = dynamic_cast<Gate*>(children[i]);
+		if (g)
+			g->place(p);
+		else
+			children[i]->setPosition(p);
 	}
-	if (n->getParent() && maxX[i - 1] > maxX[i])
-		maxX[i] = maxX[i - 1];
-	p.setX(maxX[i]);
-	n->setPosition(p);
-	maxX[i] += CARD_X;
+	placed = true;
 }
 
 void Gate::balanceNodePos()
 {
-	QVector<int> maxX(64);
-	first_pass(this, 0, maxX);
+	layout();
+	int x = 0;
+	for (int l : contourLeft)
+		x = qMin(x, l);
+	place(QPoint(-x, 0)); // le noeud le plus à gauche est en 0
 }
 
 void Gate::remove()
@@ -16,6 +16,7 @@ bool Inhibit::getCondition() const
 void Inhibit::setCondition(bool condition)
 {
     this->condition = condition;
+	prop.setChanged();
 }
 
 bool Inhibit::check (QList<QString>& errors)
@@ -0,0 +1,74 @@
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+#include "NamePool.hh"
+
+// Les analyses créent aussi des objets nommés depuis leur thread
+struct Pool
+{
+	QMutex				mutex;
+	QHash<QString, int>	ids;
+	QVector<QString>	names; // names[id]
+	QVector<int>		counts; // references to names[id]
+	QVector<int>		freeIds;
+};
+
+// Construit au premier appel: des Properties peuvent être créées avant main()
+static Pool &pool()
+{
+	static Pool p;
+	return (p);
+}
+
+int NamePool::intern(QString &name)
+{
+	Pool &p = pool();
+	QMutexLocker lock(&p.mutex);
+	auto it = p.ids.constFind(name);
+	if (it != p.ids.constEnd())
+	{
+		name = p.names[it.value()];
+		++p.counts[it.value()];
+		return (it.value());
+	}
+	int id;
+	if (p.freeIds.size())
+	{
+		id = p.freeIds.takeLast();
+		p.names[id] = name;
+		p.counts[id] = 1;
+	}
+	else
+	{
+		id = p.names.size();
+		p.names << name;
+		p.counts << 1;
+	}
+	p.ids.insert(name, id);
+	return (id);
+}
+
+void NamePool::retain(int id)
+{
+	Pool &p = pool();
+	QMutexLocker lock(&p.mutex);
+	++p.counts[id];
+}
+
+void NamePool::release(int id)
+{
+	Pool &p = pool();
+	QMutexLocker lock(&p.mutex);
+	if (--p.counts[id])
+		return ;
+	p.ids.remove(p.names[id]);
+	p.names[id] = QString();
+	p.freeIds << id;
+}
+
+int NamePool::find(const QString &name)
+{
+	Pool &p = pool();
+	QMutexLocker lock(&p.mutex);
+	return (p.ids.value(name, -1));
+}
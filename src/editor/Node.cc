@@ -29,11 +29,15 @@ void Node::attach(Gate* parent)
 		return ;
 	this->parent = parent;
 	parent->getChildren() << this;
+	parent->invalidateLayout();
 }
 
 void Node::detach()
 {
 	if (parent)
+	{
 		parent->getChildren().removeOne(this);
+		parent->invalidateLayout();
+	}
 	parent = nullptr;
 }
@@ -13,6 +13,7 @@ Node* PasteVisitor::getPasted() const
 void PasteVisitor::visitChildren(Gate& gate,Gate* child)
 {
     e.getGates() << child;
+    e.addName(child->getProperties().getName());
     if(!pasted)
         pasted = child; 
     child->attach(this->parent);
@@ -69,6 +70,7 @@ void PasteVisitor::visit(Container& container)
 {
     (void)container;
     e.getEvents() << Event(e.generateName(PREFIX_EVENT));
+    e.addName(e.getEvents().last().getProperties().getName());
     auto cont = new Container(&e.getEvents().last());
     
     if(!pasted)
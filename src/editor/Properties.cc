@@ -1,16 +1,42 @@
 #include "Properties.hh"
 
-Properties::Properties(QString name, bool keep) : name(name), refCount(0), keep(keep)
+Properties::Properties(QString name, bool keep) : name(name), nameId(NamePool::intern(this->name)), refCount(0), keep(keep), changed(true)
 {}
 
+Properties::Properties(const Properties &other) : name(other.name), nameId(other.nameId), desc(other.desc),
+refCount(other.refCount), keep(other.keep), changed(other.changed)
+{
+	NamePool::retain(nameId);
+}
+
 Properties::~Properties()
-{}
+{
+	NamePool::release(nameId);
+}
+
+Properties &Properties::operator=(const Properties &other)
+{
+	NamePool::retain(other.nameId);
+	NamePool::release(nameId);
+	name = other.name;
+	nameId = other.nameId;
+	desc = other.desc;
+	refCount = other.refCount;
+	keep = other.keep;
+	changed = other.changed;
+	return (*this);
+}
 
 QString Properties::getName() const
 {
 	return (name);
 }
 
+int Properties::getNameId() const
+{
+	return (nameId);
+}
+
 QString Properties::getDesc() const
 {
 	return (desc);
@@ -26,19 +52,35 @@ bool Properties::getKeep() const
 	return (keep);
 }
 
+bool Properties::isChanged() const
+{
+	return (changed);
+}
+
 void Properties::setName(QString name)
 {
+	int old = nameId;
 	this->name = name;
+	nameId = NamePool::intern(this->name);
+	NamePool::release(old);
+	changed = true;
 }
 
 void Properties::setDesc(QString desc)
 {
 	this->desc = desc;
+	changed = true;
 }
 
 void Properties::setKeep(bool keep)
 {
 	this->keep = keep;
+	changed = true;
+}
+
+void Properties::setChanged(bool changed)
+{
+	this->changed = changed;
 }
 
 void Properties::decrementRefCount()
@@ -1,3 +1,4 @@
+#include "Gate.hh"
 #include "Transfert.hh"
 #include "VisitorNode.hh"
 #include "EvalVisitor.hh"
@@ -20,6 +21,8 @@ void Transfert::setLink(Tree* link)
 	this->link = link;
 	if (link)
 		link->getProperties().incrementRefCount();
+	if (parent)
+		parent->getProperties().setChanged();
 }
 
 bool Transfert::check(QList<QString>& errors)
@@ -24,4 +24,5 @@ void Tree::setTop(Gate *top)
 	this->top = top;
 	if (top)
 		top->getProperties().incrementRefCount();
+	prop.setChanged();
 }
\ No newline at end of file
@@ -58,6 +58,7 @@ void VotingOR::setK(int k)
 	this->k = 0;
 	updateSubTree();
     this->k = k;
+	prop.setChanged();
 }
 
 Gate* VotingOR::getSubTree()
@@ -2,6 +2,7 @@
 #include <limits>
 #include <QtGlobal>
 #include "Distribution.hh"
+#include "DistributionKernels.hh"
 #include "VisitorDistribution.hh"
 
 Weibull::Weibull(QString name) : Distribution(name), shape(0)
@@ -22,17 +23,24 @@ double Weibull::getShape()
 
 double Weibull::getProbability(double time)
 {
-	return(1-exp(-pow((time/value),shape)));
+	return(-expm1(-pow((time/value),shape))); // 1 - exp(...) without cancellation
+}
+
+void Weibull::getProbabilities(const double *times, double *out, int n)
+{
+	weibullKernel(value, shape, times, out, n);
 }
 
 void Weibull::setScale(double scale)
 {
 	value = qBound(0.0,scale,std::numeric_limits<double>::max());
+	prop.setChanged();
 }
 
 void Weibull::setShape(double shape)
 {
 	this->shape = qBound(0.0,shape,std::numeric_limits<double>::max());
+	prop.setChanged();
 }
 
 void Weibull::accept(VisitorDistribution& visitor)
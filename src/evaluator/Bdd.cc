@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <limits>
+#include "Bdd.hh"
+
+bool BddKey::operator==(const BddKey &key) const
+{
+	return (a == key.a && b == key.b && c == key.c);
+}
+
+uint qHash(const BddKey &key, uint seed)
+{
+	return (((uint)key.a * 73856093u) ^ ((uint)key.b * 19349663u) ^ ((uint)key.c * 83492791u) ^ seed);
+}
+
+Bdd::Bdd(const Progress *progress) : nbVars(0), progress(progress)
+{
+	int last = std::numeric_limits<int>::max(); // terminals are below every variable
+	vertices << Vertex{last, BDD_FALSE, BDD_FALSE} << Vertex{last, BDD_TRUE, BDD_TRUE};
+}
+
+Bdd::~Bdd()
+{}
+
+int Bdd::makeVertex(int var, int low, int high)
+{
+	if (low == high) // useless test
+		return (low);
+	BddKey key{var, low, high};
+	auto i = unique.constFind(key);
+	if (i != unique.constEnd())
+		return (i.value());
+	vertices << Vertex{var, low, high};
+	unique.insert(key, vertices.size() - 1);
+	return (vertices.size() - 1);
+}
+
+int Bdd::topVar(int f) const
+{
+	return (vertices[f].var);
+}
+
+int Bdd::low(int f, int var) const
+{
+	return (vertices[f].var == var ? vertices[f].low : f);
+}
+
+int Bdd::high(int f, int var) const
+{
+	return (vertices[f].var == var ? vertices[f].high : f);
+}
+
+int Bdd::variable(int var)
+{
+	nbVars = qMax(nbVars, var + 1);
+	return (makeVertex(var, BDD_FALSE, BDD_TRUE));
+}
+
+int Bdd::ite(int f, int g, int h)
+{
+	if (f == BDD_TRUE)
+		return (g);
+	if (f == BDD_FALSE)
+		return (h);
+	if (g == h)
+		return (g);
+	if (g == BDD_TRUE && h == BDD_FALSE)
+		return (f);
+	if (progress && progress->isCanceled()) // la taille du diagramme peut exploser, l'analyse est abandonnée
+		return (BDD_FALSE);
+	BddKey key{f, g, h};
+	auto i = computed.constFind(key);
+	if (i != computed.constEnd())
+		return (i.value());
+	int var = qMin(topVar(f), qMin(topVar(g), topVar(h)));
+	int l = ite(low(f, var), low(g, var), low(h, var));
+	int r = makeVertex(var, l, ite(high(f, var), high(g, var), high(h, var)));
+	computed.insert(key, r);
+	return (r);
+}
+
+int Bdd::negation(int f)
+{
+	return (ite(f, BDD_FALSE, BDD_TRUE));
+}
+
+int Bdd::conjunction(int f, int g)
+{
+	return (ite(f, g, BDD_FALSE));
+}
+
+int Bdd::disjunction(int f, int g)
+{
+	return (ite(f, BDD_TRUE, g));
+}
+
+int Bdd::exclusion(int f, int g)
+{
+	return (ite(f, negation(g), g));
+}
+
+int Bdd::atLeast(int k, const QVector<int> &functions)
+{
+	int n = functions.size();
+	if (k <= 0)
+		return (BDD_TRUE);
+	if (k > n)
+		return (BDD_FALSE);
+	// t[j] = at least j of the functions i..n-1 are true
+	QVector<int> t(k + 1, BDD_FALSE);
+	t[0] = BDD_TRUE;
+	for (int i = n - 1; i >= 0; --i)
+		for (int j = qMin(k, n - i); j > 0; --j)
+			t[j] = ite(functions[i], t[j - 1], t[j]);
+	return (t[k]);
+}
+
+QVector<int> Bdd::reachable(int f) const
+{
+	QVector<int> order;
+	QVector<bool> visited(vertices.size(), false);
+	QVector<int> stack;
+	stack << f;
+	while (stack.size())
+	{
+		int v = stack.last();
+		stack.removeLast();
+		if (visited[v])
+			continue ;
+		visited[v] = true;
+		if (v == f || v > BDD_TRUE) // terminals are only kept when f is constant
+			order << v;
+		if (v > BDD_TRUE)
+			stack << vertices[v].low << vertices[v].high;
+	}
+	std::sort(order.begin(), order.end()); // a vertex is always created after its children
+	return (order);
+}
+
+double Bdd::probability(int f, const QVector<double> &p) const
+{
+	QVector<double> values(vertices.size());
+	return (probability(reachable(f), p, values));
+}
+
+double Bdd::probability(const QVector<int> &order, const QVector<double> &p, QVector<double> &values) const
+{
+	values[BDD_FALSE] = 0;
+	values[BDD_TRUE] = 1;
+	for (int v : order)
+	{
+		if (v <= BDD_TRUE)
+			continue ;
+		const Vertex &x = vertices[v];
+		values[v] = p[x.var] * values[x.high] + (1 - p[x.var]) * values[x.low];
+	}
+	return (values[order.last()]);
+}
+
+int Bdd::getSize() const
+{
+	return (vertices.size());
+}
+
+int Bdd::getNbVars() const
+{
+	return (nbVars);
+}
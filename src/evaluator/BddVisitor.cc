@@ -0,0 +1,86 @@
+#include "BddVisitor.hh"
+
+BddVisitor::BddVisitor(Bdd& bdd, QList<Event*>& events) : bdd(bdd), events(events), result(BDD_FALSE)
+{}
+
+BddVisitor::~BddVisitor()
+{}
+
+int BddVisitor::compile(Node *n)
+{
+	if (!compiled(n))
+	{
+		n->accept(*this);
+		if (dynamic_cast<Gate*>(n))
+			gates.insert(n, result);
+	}
+	return (result);
+}
+
+bool BddVisitor::compiled(Node *gate)
+{
+	int f = gates.value(gate, -1);
+	if (f == -1)
+		return (false);
+	result = f;
+	return (true);
+}
+
+QVector<int> BddVisitor::compileChildren(Gate& gate)
+{
+	QVector<int> functions;
+	for (Node *child : gate.getChildren())
+		functions << compile(child);
+	return (functions);
+}
+
+void BddVisitor::visit(And& andgate)
+{
+	int f = BDD_TRUE;
+	for (int g : compileChildren(andgate))
+		f = bdd.conjunction(f, g);
+	result = f;
+}
+
+void BddVisitor::visit(Or& orgate)
+{
+	int f = BDD_FALSE;
+	for (int g : compileChildren(orgate))
+		f = bdd.disjunction(f, g);
+	result = f;
+}
+
+void BddVisitor::visit(Xor& xorgate)
+{
+	QVector<int> functions = compileChildren(xorgate); // Xor n'a que 2 enfants.
+	result = bdd.exclusion(functions[0], functions[1]);
+}
+
+void BddVisitor::visit(VotingOR& vorgate)
+{
+	result = bdd.atLeast(vorgate.getK(), compileChildren(vorgate));
+}
+
+void BddVisitor::visit(Inhibit& inhibgate)
+{
+	int f = compile(inhibgate.getChildren().at(0));
+	result = inhibgate.getCondition() ? f : BDD_FALSE;
+}
+
+void BddVisitor::visit(Transfert& transfertgate)
+{
+	compile(transfertgate.getLink()->getTop());
+}
+
+void BddVisitor::visit(Container& container)
+{
+	Event *e = container.getEvent();
+	int var = vars.value(e, -1);
+	if (var == -1) // variables are ordered by first occurrence
+	{
+		var = events.size();
+		vars.insert(e, var);
+		events << e;
+	}
+	result = bdd.variable(var);
+}
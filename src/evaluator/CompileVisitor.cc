@@ -0,0 +1,81 @@
+#include "CompileVisitor.hh"
+
+CompileVisitor::CompileVisitor(QList<Event*>& events, QVector<Instruction>& code, QVector<int>& operands) :
+events(events), code(code), operands(operands), result(0)
+{}
+
+CompileVisitor::~CompileVisitor()
+{}
+
+int CompileVisitor::compile(Node *n)
+{
+	auto i = gates.constFind(n);
+	if (i != gates.constEnd())
+		return (i.value());
+	n->accept(*this);
+	if (dynamic_cast<Gate*>(n))
+		gates.insert(n, result);
+	return (result);
+}
+
+void CompileVisitor::emitInstruction(Instruction::Opcode op, const QVector<int> &args)
+{
+	code << Instruction{op, operands.size(), operands.size() + args.size()};
+	operands << args;
+	result = code.size() - 1;
+}
+
+QVector<int> CompileVisitor::compileChildren(Gate& gate)
+{
+	QVector<int> args;
+	for (Node *child : gate.getChildren())
+		args << compile(child);
+	return (args);
+}
+
+void CompileVisitor::visit(And& andgate)
+{
+	emitInstruction(Instruction::AND, compileChildren(andgate));
+}
+
+void CompileVisitor::visit(Or& orgate)
+{
+	emitInstruction(Instruction::OR, compileChildren(orgate));
+}
+
+void CompileVisitor::visit(Xor& xorgate)
+{
+	emitInstruction(Instruction::XOR, compileChildren(xorgate)); // Xor n'a que 2 enfants.
+}
+
+void CompileVisitor::visit(VotingOR& vorgate)
+{
+	result = compile(vorgate.getSubTree()); // same expansion as EvalVisitor
+}
+
+void CompileVisitor::visit(Inhibit& inhibgate)
+{
+	if (inhibgate.getCondition())
+		emitInstruction(Instruction::AND, QVector<int>{compile(inhibgate.getChildren().at(0))});
+	else
+		emitInstruction(Instruction::OR, QVector<int>()); // an empty Or is always false
+}
+
+void CompileVisitor::visit(Transfert& transfertgate)
+{
+	compile(transfertgate.getLink()->getTop());
+}
+
+void CompileVisitor::visit(Container& container)
+{
+	Event *e = container.getEvent();
+	auto i = eventSlots.constFind(e);
+	if (i != eventSlots.constEnd())
+	{
+		result = i.value();
+		return ;
+	}
+	result = ~events.size();
+	eventSlots.insert(e, result);
+	events << e;
+}
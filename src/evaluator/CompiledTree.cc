@@ -0,0 +1,103 @@
+#include <algorithm>
+#include "CompiledTree.hh"
+
+CompiledTree::CompiledTree(Gate *top)
+{
+	CompileVisitor compiler(events, code, operands);
+
+	root = compiler.compile(top);
+	// Events are placed before the gates
+	int nbEvents = events.size();
+	for (int &i : operands)
+		i = i < 0 ? ~i : nbEvents + i;
+	root = root < 0 ? ~root : nbEvents + root;
+	for (Event *e : events)
+		table.append(e);
+	values.resize(nbEvents + code.size());
+}
+
+CompiledTree::~CompiledTree()
+{}
+
+double CompiledTree::getProba(double time)
+{
+	int nbEvents = events.size();
+	double *v = values.data();
+	const int *args = operands.constData();
+
+	table.getProbabilities(time, v);
+	for (const Instruction &ins : code)
+	{
+		double r;
+		switch (ins.op)
+		{
+			case Instruction::AND:
+				r = 1;
+				for (int i = ins.first; i < ins.last; ++i)
+					r *= v[args[i]];
+				break ;
+			case Instruction::OR:
+				r = 0;
+				for (int i = ins.first; i < ins.last; ++i)
+					r += v[args[i]];
+				r = qBound(0.0, r, 1.0);
+				break ;
+			default: // XOR
+				r = v[args[ins.first]] * (1 - v[args[ins.first + 1]])
+				+ (1 - v[args[ins.first]]) * v[args[ins.first + 1]];
+		}
+		v[nbEvents++] = r;
+	}
+	return (v[root]);
+}
+
+void CompiledTree::getProbabilities(const double *times, double *out, int n, Progress *progress) const
+{
+	int nbEvents = events.size();
+	int nbValues = nbEvents + code.size();
+	int block = qBound(16, (1 << 15) / nbValues, 1024); // the buffer stays around 256 KB
+	QVector<double> rows(nbValues * block); // rows[i * block + j] = values[i] at times[j]
+	const int *args = operands.constData();
+
+	for (int t = 0; t < n && !(progress && progress->isCanceled()); t += block)
+	{
+		int m = qMin(block, n - t);
+		double *v = rows.data();
+		for (int i = 0; i < nbEvents; ++i)
+			table.getProbabilities(i, times + t, v + i * block, m);
+		double *r = v + nbEvents * block;
+		for (const Instruction &ins : code)
+		{
+			switch (ins.op)
+			{
+				case Instruction::AND:
+					std::fill(r, r + m, 1.0);
+					for (int i = ins.first; i < ins.last; ++i)
+						andKernel(r, v + args[i] * block, m);
+					break ;
+				case Instruction::OR:
+					std::fill(r, r + m, 0.0);
+					for (int i = ins.first; i < ins.last; ++i)
+						orKernel(r, v + args[i] * block, m);
+					boundKernel(r, m);
+					break ;
+				default: // XOR
+					xorKernel(r, v + args[ins.first] * block, v + args[ins.first + 1] * block, m);
+			}
+			r += block;
+		}
+		std::copy(v + root * block, v + root * block + m, out + t);
+		if (progress)
+			progress->advance(m);
+	}
+}
+
+int CompiledTree::getNbEvents() const
+{
+	return (events.size());
+}
+
+int CompiledTree::getNbGates() const
+{
+	return (code.size());
+}
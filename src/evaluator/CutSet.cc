@@ -0,0 +1,60 @@
+#include <algorithm>
+#include "CutSet.hh"
+
+CutSetMinimizer::CutSetMinimizer(int nbEvents) : byFirst(nbEvents)
+{}
+
+CutSetMinimizer::~CutSetMinimizer()
+{}
+
+void CutSetMinimizer::normalize(CutSet &cut)
+{
+	std::sort(cut.begin(), cut.end());
+	cut.erase(std::unique(cut.begin(), cut.end()), cut.end()); // ee = e
+}
+
+bool CutSetMinimizer::isAbsorbed(const CutSet &cut) const
+{
+	// the smallest event of an included cut set is always in cut
+	for (auto e = cut.constBegin(); e != cut.constEnd() && *e < byFirst.size(); ++e)
+		for (int i : byFirst[*e])
+			if (std::includes(e, cut.constEnd(), cuts[i].constBegin(), cuts[i].constEnd()))
+				return (true);
+	return (false);
+}
+
+void CutSetMinimizer::insert(const CutSet &cut)
+{
+	if (cut.isEmpty())
+		return ;
+	if (cut.first() >= byFirst.size()) // new events can still be found
+		byFirst.resize(cut.first() + 1);
+	byFirst[cut.first()] << cuts.size();
+	cuts << cut;
+}
+
+QList<CutSet> &CutSetMinimizer::getCutSets()
+{
+	return (cuts);
+}
+
+static bool lessOrder(const CutSet &a, const CutSet &b)
+{
+	if (a.size() != b.size())
+		return (a.size() < b.size());
+	return (std::lexicographical_compare(a.constBegin(), a.constEnd(), b.constBegin(), b.constEnd()));
+}
+
+QList<CutSet> CutSetMinimizer::minimize(QList<CutSet> &cuts, int nbEvents)
+{
+	CutSetMinimizer m(nbEvents);
+
+	for (CutSet &cut : cuts)
+		normalize(cut);
+	// a cut set can only be absorbed by a smaller one
+	std::sort(cuts.begin(), cuts.end(), lessOrder);
+	for (int i = 0; i < cuts.size(); ++i)
+		if (!cuts[i].isEmpty() && (!i || cuts[i] != cuts[i - 1]) && !m.isAbsorbed(cuts[i]))
+			m.insert(cuts[i]);
+	return (m.cuts);
+}
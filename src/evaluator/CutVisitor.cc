@@ -1,87 +1,147 @@
+#include <algorithm>
 #include "CutVisitor.hh"
 
-CutVisitor::CutVisitor(QList<QList<Node*>>& cutset, QList<Container*>& containers) : cutset(cutset), containers(containers){}
+CutVisitor::CutVisitor(QList<Event*>& events, QVector<PartialCut>& work) : events(events), work(work){}
 
-CutVisitor::~CutVisitor(){}
-
-void CutVisitor::setIndex(int i, int j)
+CutVisitor::~CutVisitor()
 {
-    this->i = i;
-    this->j = j;
+    while(containers.size())
+    {
+        Event *event = containers.first()->getEvent();
+        Distribution *dist = event->getDistribution();
+        delete containers.first();
+        delete event;
+        delete dist;
+        containers.removeFirst();
+    }
 }
 
-void CutVisitor::visit(And& andgate)/*si c'est une Porte AND*/
+int CutVisitor::getIndex(Event* e)
 {
-    QList<Node*>& childrens=andgate.getChildren();/*recuperer les fils de cette porte*/
-    cutset[i][j] = childrens.at(0);
-    for(int m=1; m<childrens.size();m++)
+    int i = index.value(e, -1);
+    if(i == -1)/*les index sont donnes dans l'ordre de decouverte*/
     {
-        cutset[i].append(childrens[m]);
+        i = events.size();
+        index.insert(e, i);
+        events.append(e);
     }
+    return i;
 }
 
-void CutVisitor::visit(Or& orgate)
+void CutVisitor::add(PartialCut& c, Node* n)
 {
-    QList<Node*> *lstcopy; /*un pointeur pointe les nouvelle listes vide*/
-    QList<Node*>& childrens = orgate.getChildren();
+    Container* container = dynamic_cast<Container*>(n);
+    Transfert* transfert = dynamic_cast<Transfert*>(n);
 
-    cutset[i][j] = childrens.at(0);/*remplacer cette porte par son premier fils*/
-    for(int m=1; m<childrens.size();m++)/*parcourir les enfants*/
-    { 
-        lstcopy = new QList<Node*>;/*faire le pointeur pointe une autre nouvelle liste vide*/
-
-        for(int n=0; n<cutset[i].size();n++)/*copier une nouvelle liste avec le même contenu*/
-        {
-            lstcopy->append(cutset[i][n]);
-        }
-        lstcopy->replace(j,childrens.at(m));/*mettre les autres fils dans la meme position de leurs listes*/
-        cutset.append(*lstcopy); /*mettre cette nouvelle liste a la fin de cs*/
+    if(container)/*inserer l'index en gardant la coupe triee, ee = e*/
+    {
+        int i = getIndex(container->getEvent());
+        auto it = std::lower_bound(c.events.begin(), c.events.end(), i);
+        if(it == c.events.end() || *it != i)
+            c.events.insert(it, i);
     }
+    else if(transfert)
+        add(c, transfert->getLink()->getTop());
+    else if(!c.gates.contains(n))
+        c.gates.append(n);
 }
 
-
-void CutVisitor::visit(Xor& xorgate)
+void CutVisitor::expand(const PartialCut& cut, Node* gate)
 {
-    QList<Node*> lstcopy; // pour mettre la copie de la liste.
+    this->cut = cut;
+    gate->accept(*this);
+}
 
-    cutset[i][j] = xorgate.getChildren().at(0);/*remplacer cette porte de son premier fils*/
-    for(int n=0; n<cutset[i].size();n++)/*copier une nouvelle liste avec le meme contenu*/
+void CutVisitor::visit(And& andgate)/*si c'est une Porte AND, tous les fils sont dans la meme coupe*/
+{
+    for(Node* child : andgate.getChildren())
     {
-        lstcopy.append(cutset[i][n]);
+        add(cut, child);
     }
-    /*remplacer cette porte de son deuxieme fils dans la copie*/
-    lstcopy[j]=xorgate.getChildren().at(1);// Xor n'a que 2 enfants.
-    cutset.append(lstcopy);/*ajoute la copie dans le matrice*/
+    work.append(cut);
 }
 
-void CutVisitor::visit(VotingOR& vorgate)
+void CutVisitor::visit(Or& orgate)/*une nouvelle coupe par fils*/
 {
-        Gate* vor = vorgate.getSubTree();
-        cutset[i][j] = vor;    
+    for(Node* child : orgate.getChildren())
+    {
+        PartialCut c = cut;
+        add(c, child);
+        work.append(c);
+    }
 }
 
-void CutVisitor::visit(Inhibit& inhibgate)
+void CutVisitor::visit(Xor& xorgate)/*meme developpement que Or*/
 {
-    Event* cond = new Event("condition of " + inhibgate.getProperties().getName());
-    Constant* proba = new Constant("probability of " + inhibgate.getProperties().getName());
-    proba->setValue(inhibgate.getCondition()==true);
-    cond->setDistribution(proba);
-    Container* condition = new Container(cond);
+    for(Node* child : xorgate.getChildren())
+    {
+        PartialCut c = cut;
+        add(c, child);
+        work.append(c);
+    }
+}
 
-    containers.append(condition);
+void CutVisitor::visit(VotingOR& vorgate)/*une nouvelle coupe par combinaison de k fils parmi n*/
+{
+    QList<Node*>& children = vorgate.getChildren();
+    int k = vorgate.getK(), n = children.size();
+    QVector<int> comb(k);
 
-    cutset[i][j] = inhibgate.getChildren().at(0);/*ajouter le fils de inhibit*/
-    cutset[i].append(condition);/*ajouter sa condition*/
+    for(int i=0; i<k; i++)
+    {
+        comb[i] = i;
+    }
+    while(true)
+    {
+        PartialCut c = cut;
+        for(int i=0; i<k; i++)
+        {
+            add(c, children[comb[i]]);
+        }
+        work.append(c);
+        int i = k - 1;/*combinaison suivante*/
+        while(i >= 0 && comb[i] == n - k + i)
+        {
+            i--;
+        }
+        if(i < 0)
+        {
+            break;
+        }
+        comb[i]++;
+        for(int j=i+1; j<k; j++)
+        {
+            comb[j] = comb[j - 1] + 1;
+        }
+    }
+}
 
+void CutVisitor::visit(Inhibit& inhibgate)/*le fils et sa condition*/
+{
+    Container* condition = conditions.value(&inhibgate, nullptr);
+    if(!condition)/*la condition n'est creee qu'une fois par porte*/
+    {
+        Event* cond = new Event("condition of " + inhibgate.getProperties().getName());
+        Constant* proba = new Constant("probability of " + inhibgate.getProperties().getName());
+        proba->setValue(inhibgate.getCondition()==true);
+        cond->setDistribution(proba);
+        condition = new Container(cond);
+        containers.append(condition);
+        conditions.insert(&inhibgate, condition);
+    }
+    add(cut, inhibgate.getChildren().at(0));/*ajouter le fils de inhibit*/
+    add(cut, condition);/*ajouter sa condition*/
+    work.append(cut);
 }
 
 void CutVisitor::visit(Transfert& transfertgate)
 {
-    cutset[i][j] = transfertgate.getLink()->getTop();
+    add(cut, transfertgate.getLink()->getTop());
+    work.append(cut);
 }
 
 void CutVisitor::visit(Container& container)
 {
-    container.getEvent()->getProperties().getName();
+    add(cut, &container);
+    work.append(cut);
 }
-
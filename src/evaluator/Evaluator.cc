@@ -1,11 +1,17 @@
 #include "Gate.hh"
 #include "Evaluator.hh"
 
-Evaluator::Evaluator(Gate* top,double missionTime, double step)
+Evaluator::Evaluator(Gate* top,double missionTime, double step, Progress* progress)
 {
 	this->top = top;
 	this->missionTime = missionTime;
 	this->step = step;
+	this->progress = progress;
+}
+
+bool Evaluator::canceled()
+{
+	return progress && progress->isCanceled();
 }
 
 Evaluator::~Evaluator(){}
@@ -19,6 +25,17 @@ double Evaluator::getStep()
 	return step;
 }
 
+QVector<double> Evaluator::getTimes()
+{
+	QVector<double> times;
+	if (missionTime)
+		for(double i = 0; i <= missionTime; i = i + step)
+			times << i;
+	else
+		times << 0;
+	return times;
+}
+
 QList<double> Evaluator::getProbabilities()
 {
 	return probabilities;
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include "EventTable.hh"
+#include "DistributionKernels.hh"
+
+EventTable::EventTable()
+{}
+
+EventTable::~EventTable()
+{}
+
+int EventTable::append(Event *event)
+{
+	event->getDistribution()->accept(*this);
+	tmp.resize(qMax(exponentials.size(), weibulls.size()));
+	return (kinds.size() - 1);
+}
+
+int EventTable::size() const
+{
+	return (kinds.size());
+}
+
+void EventTable::getProbabilities(double time, double *out)
+{
+	for (int j = 0; j < constants.size(); ++j)
+		out[constants[j]] = values[j];
+	// 1 - exp(-lambda * time) is symmetric in lambda and time
+	exponentialKernel(time, lambdas.constData(), tmp.data(), exponentials.size());
+	for (int j = 0; j < exponentials.size(); ++j)
+		out[exponentials[j]] = tmp[j];
+	weibullEventsKernel(time, scales.constData(), shapes.constData(), tmp.data(), weibulls.size());
+	for (int j = 0; j < weibulls.size(); ++j)
+		out[weibulls[j]] = tmp[j];
+}
+
+void EventTable::getProbabilities(int i, const double *times, double *out, int n) const
+{
+	int j = columns[i];
+	switch (kinds[i])
+	{
+		case CONSTANT:
+			std::fill(out, out + n, values[j]);
+			break ;
+		case EXPONENTIAL:
+			exponentialKernel(lambdas[j], times, out, n);
+			break ;
+		default: // WEIBULL
+			weibullKernel(scales[j], shapes[j], times, out, n);
+	}
+}
+
+void EventTable::visit(Constant& constdistrib)
+{
+	columns << constants.size();
+	constants << kinds.size();
+	kinds << CONSTANT;
+	values << constdistrib.getValue();
+}
+
+void EventTable::visit(Exponential& expdistrib)
+{
+	columns << exponentials.size();
+	exponentials << kinds.size();
+	kinds << EXPONENTIAL;
+	lambdas << expdistrib.getLambda();
+}
+
+void EventTable::visit(Weibull& weibulldistrib)
+{
+	columns << weibulls.size();
+	weibulls << kinds.size();
+	kinds << WEIBULL;
+	scales << weibulldistrib.getScale();
+	shapes << weibulldistrib.getShape();
+}
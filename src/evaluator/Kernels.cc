@@ -0,0 +1,29 @@
+#include "Kernels.hh"
+
+FTEDIT_KERNEL
+void andKernel(double *r, const double *a, int n)
+{
+	for (int i = 0; i < n; ++i)
+		r[i] *= a[i];
+}
+
+FTEDIT_KERNEL
+void orKernel(double *r, const double *a, int n)
+{
+	for (int i = 0; i < n; ++i)
+		r[i] += a[i];
+}
+
+FTEDIT_KERNEL
+void boundKernel(double *r, int n)
+{
+	for (int i = 0; i < n; ++i)
+		r[i] = r[i] < 0.0 ? 0.0 : r[i] > 1.0 ? 1.0 : r[i];
+}
+
+FTEDIT_KERNEL
+void xorKernel(double *r, const double *a, const double *b, int n)
+{
+	for (int i = 0; i < n; ++i)
+		r[i] = a[i] * (1 - b[i]) + (1 - a[i]) * b[i];
+}
@@ -0,0 +1,38 @@
+#include "Progress.hh"
+
+Progress::Progress() : canceled(false), done(0), total(0)
+{}
+
+Progress::~Progress()
+{}
+
+void Progress::cancel()
+{
+	canceled.store(true, std::memory_order_relaxed);
+}
+
+bool Progress::isCanceled() const
+{
+	return (canceled.load(std::memory_order_relaxed));
+}
+
+void Progress::start(int total)
+{
+	done.store(0, std::memory_order_relaxed);
+	this->total.store(total, std::memory_order_relaxed);
+}
+
+void Progress::advance(int n)
+{
+	done.fetch_add(n, std::memory_order_relaxed);
+}
+
+int Progress::getDone() const
+{
+	return (done.load(std::memory_order_relaxed));
+}
+
+int Progress::getTotal() const
+{
+	return (total.load(std::memory_order_relaxed));
+}
@@ -2,26 +2,42 @@
 #include <QString>
 #include <QList>
 
-Result::Result(Gate* top,bool useMCS,bool useBoolean,double missionTime,double step) : resultMCS(nullptr), resultBoolean(nullptr) 
+Result::Result(Gate* top,bool useMCS,bool useBoolean,bool useBDD,double missionTime,double step,int maxOrder,double cutoff,
+Progress* progress) : resultMCS(nullptr), resultBoolean(nullptr), resultBDD(nullptr), canceled(false)
 {	
 	if(top->check( this->errors ))
 	{
 		if(useMCS)
 		{
-			resultMCS = new ResultMCS(top,missionTime,step);
+			resultMCS = new ResultMCS(top,missionTime,step,maxOrder,cutoff,progress);
 		}
-		if(useBoolean)
+		if(useBoolean && !(progress && progress->isCanceled()))
 		{
-			resultBoolean = new ResultBoolean(top,missionTime,step);	
+			resultBoolean = new ResultBoolean(top,missionTime,step,progress);	
+		}
+		if(useBDD && !(progress && progress->isCanceled()))
+		{
+			resultBDD = new ResultBDD(top,missionTime,step,progress);
 		}
 	}
 	this->errors.removeDuplicates();
+	if(progress && progress->isCanceled())/*les resultats partiels sont faux*/
+	{
+		canceled = true;
+		delete resultBoolean;
+		delete resultMCS;
+		delete resultBDD;
+		resultMCS = nullptr;
+		resultBoolean = nullptr;
+		resultBDD = nullptr;
+	}
 }
 
 Result::~Result()
 {
 	delete resultBoolean;
 	delete resultMCS;
+	delete resultBDD;
 }
 
 QStringList& Result::getErrors()
@@ -38,3 +54,13 @@ ResultBoolean* Result::getResultBoolean()
 {
 	return this->resultBoolean;
 }
+
+ResultBDD* Result::getResultBDD()
+{
+	return this->resultBDD;
+}
+
+bool Result::isCanceled()
+{
+	return this->canceled;
+}
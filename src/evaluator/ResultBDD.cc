@@ -0,0 +1,53 @@
+#include "ResultBDD.hh"
+
+#define TIME_BLOCK	256 // time points whose event probabilities are computed at once
+
+ResultBDD::ResultBDD(Gate* top, double missionTime, double step, Progress* progress) :
+Evaluator(top, missionTime, step, progress)
+{
+	Bdd bdd(progress);
+	QList<Event*> events;
+	BddVisitor visitor(bdd, events);
+
+	// la structure du diagramme ne depend pas du temps, on le compile une seule fois
+	int f = visitor.compile(top);
+	size = 0;
+	if (canceled())
+		return ;
+	QVector<int> order = bdd.reachable(f);
+	QVector<double> p(events.size());
+	QVector<double> values(bdd.getSize());
+	size = order.size();
+
+	EventTable table;
+	for (Event *e : events)
+		table.append(e);
+
+	QVector<double> times = getTimes();
+	// block[i * TIME_BLOCK + j] = proba de l'event i au temps t + j, calculee par lot pour chaque event
+	QVector<double> block(events.size() * TIME_BLOCK);
+	if (progress)
+		progress->start(times.size());
+	for (int t = 0; t < times.size() && !canceled(); t += TIME_BLOCK)
+	{
+		int m = qMin(TIME_BLOCK, times.size() - t);
+		for (int i = 0; i < events.size(); i++)
+			table.getProbabilities(i, times.constData() + t, block.data() + i * TIME_BLOCK, m);
+		for (int j = 0; j < m && !canceled(); j++)
+		{
+			for (int i = 0; i < events.size(); i++)
+				p[i] = block[i * TIME_BLOCK + j];
+			this->probabilities << bdd.probability(order, p, values);
+			if (progress)
+				progress->advance();
+		}
+	}
+}
+
+ResultBDD::~ResultBDD()
+{}
+
+int ResultBDD::getSize()
+{
+	return size;
+}
@@ -1,14 +1,41 @@
+#include <thread>
+#include <vector>
 #include "ResultBoolean.hh"
 
-ResultBoolean::ResultBoolean(Gate* top,double missionTime,double step) : Evaluator(top,missionTime,step)
+#define MIN_CHUNK	4096 // en dessous, lancer un thread coute plus cher que le calcul
+
+ResultBoolean::ResultBoolean(Gate* top,double missionTime,double step,Progress* progress,int nbThreads) :
+Evaluator(top,missionTime,step,progress)
 {
-	EvalVisitor eval;
+	CompiledTree tree(top); // compiled once for the whole time loop
+	QVector<double> times = getTimes();
+	QVector<double> p(times.size());
+	int n = times.size();
+
+	if (progress)
+		progress->start(n);
 
-	if (this->missionTime)
-		for(double i = 0; i <= this->missionTime; i = i + this->step)
-			this->probabilities << eval.getProba(top,i);
-	else
-		this->probabilities << eval.getProba(top, 0);
+	if (nbThreads <= 0)
+		nbThreads = qMax(1, (int)std::thread::hardware_concurrency());
+	nbThreads = qBound(1, n / MIN_CHUNK, nbThreads);
+	// chaque thread remplit sa propre tranche de p, l'ordre du resultat ne depend donc pas des threads
+	int chunk = (n + nbThreads - 1) / nbThreads;
+	const double *t = times.constData();
+	double *out = p.data();
+	std::vector<std::thread> workers;
+	for (int i = 1; i < nbThreads; ++i)
+	{
+		int first = i * chunk;
+		workers.emplace_back([&tree, t, out, first, chunk, n, progress]()
+		{
+			tree.getProbabilities(t + first, out + first, qMin(chunk, n - first), progress);
+		});
+	}
+	tree.getProbabilities(t, out, qMin(chunk, n), progress); // la premiere tranche dans ce thread
+	for (std::thread &w : workers)
+		w.join();
+	if (!canceled())
+		this->probabilities = QList<double>::fromVector(p);
 }
 
 ResultBoolean::~ResultBoolean()
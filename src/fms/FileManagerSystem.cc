@@ -1,11 +1,13 @@
 #include <QFile>
+#include <QSet>
 #include <QTextStream>
 #include "FileManagerSystem.hh"
 #include "SaveVisitor.hh"
+#include "SnapshotFile.hh"
 
-FileManagerSystem::FileManagerSystem() {}
+FileManagerSystem::FileManagerSystem() : journal(nullptr) {}
 
-FileManagerSystem::~FileManagerSystem() {}
+FileManagerSystem::~FileManagerSystem() { delete journal; }
 
 QString FileManagerSystem::getErrorMessage() { return errorMessage; }
 
@@ -15,68 +17,86 @@ Editor* FileManagerSystem::load(QString path)
 {
 	errorMessage = "";
 	this->path = "";
+	delete journal; // le journal d'un modèle précédent repart d'un nouveau snapshot
+	journal = nullptr;
 
 	QFile file(path);
 	if(!file.open(QIODevice::ReadOnly)){
 		errorMessage = file.errorString();
 		return nullptr;
 	}
-	
-	QDomDocument dom;
-	QString tmperr;
-	bool parsed = dom.setContent(&file, &tmperr);
-	file.close();
-	
-	if(!parsed)
+
+	//le snapshot évite de relire le XML s'il n'a pas changé depuis
+	SnapshotFile snapshot(path);
+	Editor* editor = snapshot.read();
+	if(editor)
 	{
-		errorMessage = "This file is invalid";
-		return nullptr;
+		file.close();
+		setPath(path);
+		editor->setAutoRefresh(true);
+		editor->refresh();
+		return editor;
 	}
 
-	Editor* editor = new Editor(false);
-	XmlTreeReader xtr(editor, dom);
+	editor = new Editor(false);
+	XmlTreeReader xtr(editor, &file);
 	
 	try { xtr.read(); }
 	catch(int exp)
 	{
+		file.close();
 		delete editor;
 		errorMessage = "This file is invalid";
 		return nullptr;
 	}
+	file.close();
 	
 	setPath(path);
 	editor->setAutoRefresh(true);
 	editor->refresh();
+	snapshot.write(editor);
 	return editor;
 }
 
-void gateTreeMapping(Tree* tree, Gate* top, QMap<Tree*, Gate*>* map)
+// Portes d'un arbre en ordre préfixe, une porte partagée n'est listée qu'une fois
+static QList<Gate*> treeGates(Gate* top)
 {
-	if(!top) return ;
-	Gate *g = nullptr;
-	map->insertMulti(tree, top);
-	QList<Node*>& childs = top->getChildren();
-	for(Node* c : childs)
-		if((g = dynamic_cast<Gate*>(c)) != nullptr)
-			gateTreeMapping(tree, g, map);
+	QList<Gate*> gates;
+	QSet<Gate*> visited;
+	QList<Gate*> stack;
+	if(top) stack << top;
+	while(!stack.isEmpty())
+	{
+		Gate* g = stack.takeLast();
+		if(visited.contains(g)) continue;
+		visited.insert(g);
+		gates << g;
+		QList<Node*>& childs = g->getChildren();
+		for(int i = childs.size() - 1; i >= 0; i--)
+		{
+			Gate* c = dynamic_cast<Gate*>(childs[i]);
+			if(c && !visited.contains(c)) stack << c;
+		}
+	}
+	return gates;
 }
 
 int FileManagerSystem::save(Editor* editor)
 {
 	errorMessage = "";
-	QFile file(path); SaveVisitor svisitor;
+	QFile file(path);
 	
 	if(!file.open(QIODevice::WriteOnly))
 	{
 		errorMessage = file.errorString();
 		return -1;
 	}
-	QTextStream saveStream(&file); QDomDocument& domref = svisitor.getDomFile();
+	SaveVisitor svisitor(&file); QXmlStreamWriter& xml = svisitor.getWriter();
 	
 	//create root node of xml file
-	QDomElement root = domref.createElement("opsa-mef");
-	root.setAttribute("author", "FTEdit");
-	domref.appendChild(root);
+	xml.writeStartDocument();
+	xml.writeStartElement("opsa-mef");
+	xml.writeAttribute("author", "FTEdit");
 
 	//visit
 	for(Distribution *d :  editor->getDistributions())
@@ -84,40 +104,37 @@ int FileManagerSystem::save(Editor* editor)
 	for(Event &e :  editor->getEvents())
 		e.accept(svisitor);
 	
-	// visit gate
-	treegatemap.clear();
-	for(Tree &tree : editor->getTrees())
-	{
-		gateTreeMapping(&tree , tree.getTop(), &treegatemap);
-	}
-
-	QDomElement treeroot, treelabel, treetop;
- 
 	for(Tree &tree : editor->getTrees())
 	{
 		Properties &treeprop = tree.getProperties();
-		treeroot = domref.createElement("define-fault-tree");
+		xml.writeStartElement("define-fault-tree");
 		
-		svisitor.writeNameLabel(treeroot, treeprop);
+		svisitor.writeNameLabel(treeprop);
 		if(tree.getTop())
 		{
-			QDomElement treepropelem = domref.createElement("attributes");
-			treetop = domref.createElement("attribute");
-			treetop.setAttribute("name", "top-event");
-			treetop.setAttribute("value", tree.getTop()->getProperties().getName());
-			treepropelem.appendChild(treetop);
-			treeroot.appendChild(treepropelem);
+			xml.writeStartElement("attributes");
+			xml.writeEmptyElement("attribute");
+			xml.writeAttribute("name", "top-event");
+			xml.writeAttribute("value", tree.getTop()->getProperties().getName());
+			xml.writeEndElement();
 		}
-		svisitor.setTreeElem(treeroot);//set tree root for SaveVisitor
 
-		QList<Gate*> lgates = treegatemap.values(&tree);
-		for(Gate* g : lgates)
-			g->accept(svisitor); //visit
-		root.appendChild(treeroot);
+		// visit gate
+		for(Gate* g : treeGates(tree.getTop()))
+			g->accept(svisitor);
+		xml.writeEndElement();
 	}
 
-	saveStream << domref.toString(4);
+	xml.writeEndDocument();
+	bool failed = xml.hasError();
+	if(failed)
+		errorMessage = file.errorString();
 	file.close();
+	if(failed)
+		return -1;
+	SnapshotFile(path).write(editor);
+	if(Journal* j = currentJournal())
+		j->clear(); // les changements sont dans le fichier
 	return 0;
 }
 
@@ -128,6 +145,67 @@ int FileManagerSystem::saveAs(QString path, Editor* editor)
 
 void FileManagerSystem::setPath(QString path) {this->path = path; }
 
+Journal* FileManagerSystem::currentJournal()
+{
+	if(path.isEmpty())
+		return nullptr;
+	if(!journal || journalPath != path)
+	{
+		delete journal;
+		journal = new Journal(path);
+		journalPath = path;
+	}
+	return journal;
+}
+
+bool FileManagerSystem::hasJournal(QString path) { return Journal(path).exists(); }
+
+Editor* FileManagerSystem::recover(QString path)
+{
+	errorMessage = "";
+	this->path = "";
+
+	delete journal;
+	journal = new Journal(path);
+	journalPath = path;
+	Editor* editor = journal->recover();
+	if(!editor)
+	{
+		errorMessage = "The unsaved changes could not be restored";
+		return nullptr;
+	}
+	setPath(path);
+	editor->setAutoRefresh(true);
+	editor->refresh();
+	return editor;
+}
+
+int FileManagerSystem::autosave(Editor* editor)
+{
+	errorMessage = "";
+	Journal* j = currentJournal();
+	if(!j)
+	{
+		//le premier journal du fichier partira d'un snapshot complet
+		editor->clearFreedNames();
+		return 0; // pas encore de fichier
+	}
+	if(!j->write(editor))
+	{
+		errorMessage = "Failed to save the unsaved changes in " + path + ".journal";
+		return -1;
+	}
+	return 0;
+}
+
+void FileManagerSystem::discardJournal(QString path)
+{
+	if(journal && journalPath == path)
+		journal->clear();
+	else
+		Journal(path).clear();
+}
+
 int FileManagerSystem::exportAs(QString path, Result &result)
 {
 	errorMessage = "";
@@ -138,14 +216,26 @@ int FileManagerSystem::exportAs(QString path, Result &result)
 		file.close();
 		return -1;
 	}
-	QTextStream saveStream(&file);
+	exportTo(&file, result);
+	file.close();
+	return 0;
+}
+
+void FileManagerSystem::exportTo(QIODevice *device, Result &result)
+{
+	QTextStream saveStream(device);
 
 	ResultMCS *resmcs =  result.getResultMCS();
 	ResultBoolean *resB = result.getResultBoolean();
+	ResultBDD *resBDD = result.getResultBDD();
 
 	if(resmcs)
 	{
 		saveStream << "TopEvent propability risk:," << doubleToString(resmcs->getProbabilities().last()) << '\n';
+		if(resmcs->getMaxOrder())
+			saveStream << "Maximum order:," << resmcs->getMaxOrder() << '\n';
+		if(resmcs->getCutoff() > 0)
+			saveStream << "Probability cutoff:," << QString::number(resmcs->getCutoff(), 'g', 17) << '\n';
 		saveStream << "Probability,Quantity,Events" << '\n';
 		QList<double> proMcs = resmcs->getProbabilities();
 		QList<QList<QString>> cs = resmcs->getMCS();
@@ -179,6 +269,18 @@ int FileManagerSystem::exportAs(QString path, Result &result)
 			ctime+=mstep;
 		}
 	}
-	file.close();
-	return 0;
+
+	if(resBDD)
+	{
+		if(resmcs || resB) saveStream << "\n\n";
+
+		saveStream << "Time,Exact failure probability of " << resBDD->getTopEventName() << '\n';
+		double mstep = resBDD->getStep();
+		double ctime = 0;
+		for(double r : resBDD->getProbabilities())
+		{
+			saveStream << doubleToString(ctime) << "," << doubleToString(r) <<'\n';
+			ctime+=mstep;
+		}
+	}
 }
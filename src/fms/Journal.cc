@@ -0,0 +1,503 @@
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include "Journal.hh"
+#include "SnapshotFile.hh"
+
+// Layout of the journal: header (magic, version, hash of the snapshot it applies to), then one batch per write
+// A batch is a byte array followed by its checksum, an incomplete last batch is ignored
+// Records are keyed by a letter for the kind of object followed by its name, references to other objects are names
+// A removal gives the name only: names are unique across the kinds of objects, and removals are applied before the records
+
+#define JOURNAL_MAGIC		0x4c4e524a // "JRNL"
+#define JOURNAL_VERSION		2
+#define JOURNAL_MAX_BATCHES	64 // au-delà, les changements sont compactés dans un nouveau snapshot
+#define JOURNAL_MAX_SIZE	(4 << 20)
+
+enum { JOURNAL_REMOVE, JOURNAL_UPDATE };
+enum { JOURNAL_CONSTANT, JOURNAL_EXPONENTIAL, JOURNAL_WEIBULL };
+enum { JOURNAL_AND, JOURNAL_OR, JOURNAL_XOR, JOURNAL_VOTINGOR, JOURNAL_INHIBIT };
+enum { JOURNAL_GATE, JOURNAL_EVENT, JOURNAL_TRANSFERT };
+
+static qint32 distribType(Distribution* d)
+{
+	if(dynamic_cast<Exponential*>(d)) return JOURNAL_EXPONENTIAL;
+	if(dynamic_cast<Weibull*>(d)) return JOURNAL_WEIBULL;
+	return JOURNAL_CONSTANT;
+}
+
+static qint32 gateType(Gate* g)
+{
+	if(dynamic_cast<Or*>(g)) return JOURNAL_OR;
+	if(dynamic_cast<Xor*>(g)) return JOURNAL_XOR;
+	if(dynamic_cast<VotingOR*>(g)) return JOURNAL_VOTINGOR;
+	if(dynamic_cast<Inhibit*>(g)) return JOURNAL_INHIBIT;
+	return JOURNAL_AND;
+}
+
+static QString nameOf(Properties* prop)
+{
+	return prop ? prop->getName() : QString();
+}
+
+// Enregistrement de chaque objet de l'éditeur
+static QByteArray recordOf(Distribution* d)
+{
+	QByteArray b; QDataStream s(&b, QIODevice::WriteOnly); s.setVersion(QDataStream::Qt_5_0);
+	Properties& prop = d->getProperties();
+	Weibull* w = dynamic_cast<Weibull*>(d);
+	s << distribType(d) << prop.getDesc() << prop.getKeep() << d->getValue() << (w ? w->getShape() : 0.0);
+	return b;
+}
+
+static QByteArray recordOf(Event& evt)
+{
+	QByteArray b; QDataStream s(&b, QIODevice::WriteOnly); s.setVersion(QDataStream::Qt_5_0);
+	Properties& prop = evt.getProperties();
+	Distribution* d = evt.getDistribution();
+	s << prop.getDesc() << prop.getKeep() << nameOf(d ? &d->getProperties() : nullptr);
+	return b;
+}
+
+static QByteArray recordOf(Tree& t)
+{
+	QByteArray b; QDataStream s(&b, QIODevice::WriteOnly); s.setVersion(QDataStream::Qt_5_0);
+	Properties& prop = t.getProperties();
+	s << prop.getDesc() << prop.getKeep() << nameOf(t.getTop() ? &t.getTop()->getProperties() : nullptr);
+	return b;
+}
+
+static QByteArray recordOf(Gate* g)
+{
+	QByteArray b; QDataStream s(&b, QIODevice::WriteOnly); s.setVersion(QDataStream::Qt_5_0);
+	Properties& prop = g->getProperties();
+	qint32 param = 0;
+	if(auto v = dynamic_cast<VotingOR*>(g)) param = v->getK();
+	else if(auto inhibit = dynamic_cast<Inhibit*>(g)) param = inhibit->getCondition();
+	s << gateType(g) << prop.getDesc() << prop.getKeep() << param << (qint32)g->getChildren().size();
+	for(Node* n : g->getChildren())
+	{
+		if(auto gg = dynamic_cast<Gate*>(n))
+			s << (qint8)JOURNAL_GATE << gg->getProperties().getName();
+		else if(auto c = dynamic_cast<Container*>(n))
+			s << (qint8)JOURNAL_EVENT << c->getEvent()->getProperties().getName();
+		else if(auto transfert = dynamic_cast<Transfert*>(n))
+			s << (qint8)JOURNAL_TRANSFERT << nameOf(transfert->getLink() ? &transfert->getLink()->getProperties() : nullptr);
+	}
+	return b;
+}
+
+static void clearChanged(Editor* e)
+{
+	for(Distribution* d : e->getDistributions()) d->getProperties().setChanged(false);
+	for(Event& evt : e->getEvents()) evt.getProperties().setChanged(false);
+	for(Tree& t : e->getTrees()) t.getProperties().setChanged(false);
+	for(Gate* g : e->getGates()) g->getProperties().setChanged(false);
+}
+
+// Une porte dont le type a changé prend la place de l'ancienne
+static void replaceGate(Editor* e, Gate* old, Gate* g)
+{
+	Gate* parent = old->getParent();
+	if(parent)
+	{
+		QList<Node*>& childs = parent->getChildren();
+		int i = childs.indexOf(old);
+		old->detach();
+		g->attach(parent);
+		childs.move(childs.size() - 1, i);
+	}
+	for(Tree& t : e->getTrees())
+		if(t.getTop() == old) t.setTop(g);
+}
+
+Journal::Journal(QString xmlPath) :
+xmlPath(xmlPath), path(xmlPath + ".journal"), basePath(xmlPath + ".autosave"), base(nullptr), nbBatches(0) {}
+
+Journal::~Journal() {}
+
+bool Journal::exists() { return QFile::exists(basePath); }
+
+QByteArray Journal::baseHash()
+{
+	QFile file(basePath);
+	QCryptographicHash hash(QCryptographicHash::Md5);
+	if(!file.open(QIODevice::ReadOnly) || !hash.addData(&file))
+		return QByteArray();
+	return hash.result();
+}
+
+Editor* Journal::recover()
+{
+	Editor* e = SnapshotFile(xmlPath, basePath).read();
+	if(!e)
+		return nullptr;
+
+	QFile file(path);
+	if(file.open(QIODevice::ReadOnly))
+	{
+		QDataStream in(&file); in.setVersion(QDataStream::Qt_5_0);
+		quint32 magic = 0, version = 0;
+		QByteArray hash;
+		in >> magic >> version >> hash;
+		//un journal qui ne correspond pas au snapshot date d'avant la dernière compaction
+		if(in.status() == QDataStream::Ok && magic == JOURNAL_MAGIC && version == JOURNAL_VERSION && hash == baseHash())
+		{
+			while(!in.atEnd())
+			{
+				QByteArray batch;
+				quint16 checksum = 0;
+				in >> batch >> checksum;
+				if(in.status() != QDataStream::Ok || checksum != qChecksum(batch.constData(), batch.size()))
+					break;
+				try { apply(e, batch); }
+				catch(int exp)
+				{
+					delete e;
+					return nullptr;
+				}
+				nbBatches++;
+			}
+		}
+	}
+	//le journal peut finir par un batch tronqué ou ne plus correspondre au snapshot:
+	//la prochaine écriture repart d'un snapshot du modèle récupéré plutôt que d'ajouter à la suite
+	base = nullptr;
+	return e;
+}
+
+bool Journal::write(Editor* editor)
+{
+	//un autre modèle que celui du snapshot repart d'un nouveau snapshot
+	if(editor != base)
+		return compact(editor);
+
+	//seuls les objets marqués comme modifiés sont enregistrés, les noms libérés sont ceux des objets retirés ou renommés
+	QByteArray batch;
+	QList<Properties*> changed;
+	QDataStream out(&batch, QIODevice::WriteOnly); out.setVersion(QDataStream::Qt_5_0);
+	for(const QString& name : editor->getFreedNames())
+		out << (quint8)JOURNAL_REMOVE << name;
+	for(Distribution* d : editor->getDistributions())
+		if(d->getProperties().isChanged())
+		{
+			out << (quint8)JOURNAL_UPDATE << "D" + d->getProperties().getName() << recordOf(d);
+			changed << &d->getProperties();
+		}
+	for(Event& evt : editor->getEvents())
+		if(evt.getProperties().isChanged())
+		{
+			out << (quint8)JOURNAL_UPDATE << "E" + evt.getProperties().getName() << recordOf(evt);
+			changed << &evt.getProperties();
+		}
+	for(Tree& t : editor->getTrees())
+		if(t.getProperties().isChanged())
+		{
+			out << (quint8)JOURNAL_UPDATE << "T" + t.getProperties().getName() << recordOf(t);
+			changed << &t.getProperties();
+		}
+	for(Gate* g : editor->getGates())
+		if(g->getProperties().isChanged())
+		{
+			out << (quint8)JOURNAL_UPDATE << "G" + g->getProperties().getName() << recordOf(g);
+			changed << &g->getProperties();
+		}
+	if(batch.isEmpty())
+		return true;
+	if(nbBatches >= JOURNAL_MAX_BATCHES || QFileInfo(path).size() > JOURNAL_MAX_SIZE)
+		return compact(editor);
+
+	QFile file(path);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Append))
+		return false;
+	QDataStream stream(&file); stream.setVersion(QDataStream::Qt_5_0);
+	stream << batch << qChecksum(batch.constData(), batch.size());
+	file.close();
+	if(stream.status() != QDataStream::Ok || file.error() != QFileDevice::NoError)
+	{
+		//un batch tronqué cacherait les suivants à recover(): la prochaine écriture repart d'un snapshot
+		base = nullptr;
+		return false;
+	}
+	for(Properties* prop : changed)
+		prop->setChanged(false);
+	editor->clearFreedNames();
+	nbBatches++;
+	return true;
+}
+
+// Remplace le snapshot et repart d'un journal vide
+bool Journal::compact(Editor* editor)
+{
+	if(!SnapshotFile(xmlPath, basePath).write(editor))
+		return false;
+	QSaveFile file(path);
+	if(!file.open(QIODevice::WriteOnly))
+		return false;
+	QDataStream out(&file); out.setVersion(QDataStream::Qt_5_0);
+	out << (quint32)JOURNAL_MAGIC << (quint32)JOURNAL_VERSION << baseHash();
+	if(!file.commit())
+		return false;
+	clearChanged(editor);
+	editor->clearFreedNames();
+	base = editor;
+	nbBatches = 0;
+	return true;
+}
+
+void Journal::clear()
+{
+	QFile::remove(path);
+	QFile::remove(basePath);
+	base = nullptr;
+	nbBatches = 0;
+}
+
+void Journal::apply(Editor* e, const QByteArray& batch)
+{
+	QHash<QString, Distribution*> distribs;
+	QHash<QString, Event*> events;
+	QHash<QString, Tree*> trees;
+	QHash<QString, Gate*> gates;
+	for(Distribution* d : e->getDistributions()) distribs.insert(d->getProperties().getName(), d);
+	for(Event& evt : e->getEvents()) events.insert(evt.getProperties().getName(), &evt);
+	for(Tree& t : e->getTrees()) trees.insert(t.getProperties().getName(), &t);
+	for(Gate* g : e->getGates()) gates.insert(g->getProperties().getName(), g);
+
+	QList<QString> removed; // noms, uniques parmi tous les objets
+	QList<QPair<QString, QByteArray>> updated;
+	QDataStream in(batch); in.setVersion(QDataStream::Qt_5_0);
+	while(!in.atEnd())
+	{
+		quint8 op = 0;
+		QString key;
+		in >> op >> key;
+		if(in.status() != QDataStream::Ok || key.isEmpty()) throw -1;
+		if(op == JOURNAL_REMOVE) removed << key;
+		else if(op == JOURNAL_UPDATE)
+		{
+			QByteArray record;
+			in >> record;
+			updated << qMakePair(key, record);
+		}
+		else throw -1;
+	}
+	if(in.status() != QDataStream::Ok) throw -1;
+
+	QList<Distribution*> oldDistribs;
+	QList<Event*> oldEvents;
+	QList<Tree*> oldTrees;
+	QList<Gate*> oldGates;
+	for(const QString& name : removed)
+	{
+		if(distribs.contains(name)) oldDistribs << distribs.take(name);
+		else if(events.contains(name)) oldEvents << events.take(name);
+		else if(trees.contains(name)) oldTrees << trees.take(name);
+		else if(gates.contains(name)) oldGates << gates.take(name);
+	}
+
+	//création et mise à jour des objets, les liens sont rétablis une fois tous les objets connus
+	QList<QPair<Event*, QString>> eventDistribs;
+	QList<QPair<Tree*, QString>> treeTops;
+	QList<QPair<Gate*, qint32>> gateParams;
+	QList<QList<QPair<qint8, QString>>> gateChilds;
+	for(auto& u : updated)
+	{
+		QString name = u.first.mid(1);
+		QDataStream s(u.second); s.setVersion(QDataStream::Qt_5_0);
+		QString desc;
+		bool keep = false;
+		Properties* prop = nullptr;
+		if(u.first[0] == 'D')
+		{
+			qint32 type = 0;
+			double value = 0, shape = 0;
+			s >> type >> desc >> keep >> value >> shape;
+			Distribution* d = distribs.value(name);
+			Distribution* old = nullptr;
+			if(d && distribType(d) != type) { old = d; oldDistribs << d; d = nullptr; }
+			if(!d)
+			{
+				if(type == JOURNAL_CONSTANT) d = new Constant(name);
+				else if(type == JOURNAL_EXPONENTIAL) d = new Exponential(name);
+				else if(type == JOURNAL_WEIBULL) d = new Weibull(name);
+				else throw -1;
+				e->getDistributions() << d;
+				e->addName(name);
+				distribs.insert(name, d);
+				if(old)
+					for(Event& evt : e->getEvents())
+						if(evt.getDistribution() == old) evt.setDistribution(d);
+			}
+			d->setValue(value);
+			if(type == JOURNAL_WEIBULL) ((Weibull*)d)->setShape(shape);
+			prop = &d->getProperties();
+		}
+		else if(u.first[0] == 'E')
+		{
+			QString distrib;
+			s >> desc >> keep >> distrib;
+			Event* evt = events.value(name);
+			if(!evt)
+			{
+				e->getEvents() << Event(name);
+				evt = &e->getEvents().last();
+				e->addName(name);
+				events.insert(name, evt);
+			}
+			eventDistribs << qMakePair(evt, distrib);
+			prop = &evt->getProperties();
+		}
+		else if(u.first[0] == 'T')
+		{
+			QString top;
+			s >> desc >> keep >> top;
+			Tree* t = trees.value(name);
+			if(!t)
+			{
+				e->getTrees() << Tree(name);
+				t = &e->getTrees().last();
+				e->addName(name);
+				trees.insert(name, t);
+			}
+			treeTops << qMakePair(t, top);
+			prop = &t->getProperties();
+		}
+		else if(u.first[0] == 'G')
+		{
+			qint32 type = 0, param = 0, n = 0;
+			s >> type >> desc >> keep >> param >> n;
+			Gate* g = gates.value(name);
+			Gate* old = nullptr;
+			if(g && gateType(g) != type) { old = g; oldGates << g; g = nullptr; }
+			if(!g)
+			{
+				if(type == JOURNAL_AND) g = new And(name);
+				else if(type == JOURNAL_OR) g = new Or(name);
+				else if(type == JOURNAL_XOR) g = new Xor(name);
+				else if(type == JOURNAL_VOTINGOR) g = new VotingOR(name);
+				else if(type == JOURNAL_INHIBIT) g = new Inhibit(name);
+				else throw -1;
+				e->getGates() << g;
+				e->addName(name);
+				gates.insert(name, g);
+				if(old) replaceGate(e, old, g);
+			}
+			QList<QPair<qint8, QString>> childs;
+			for(qint32 i = 0; i < n && s.status() == QDataStream::Ok; i++)
+			{
+				qint8 kind = 0;
+				QString child;
+				s >> kind >> child;
+				childs << qMakePair(kind, child);
+			}
+			gateParams << qMakePair(g, param);
+			gateChilds << childs;
+			prop = &g->getProperties();
+		}
+		else throw -1;
+		if(s.status() != QDataStream::Ok) throw -1;
+		prop->setDesc(desc);
+		prop->setKeep(keep);
+	}
+
+	//nouveaux fils, créés avant la destruction des anciens pour ne pas perdre la distribution des events
+	QList<QList<Node*>> newChilds;
+	for(int i = 0; i < gateParams.size(); i++)
+	{
+		QList<Node*> list;
+		for(auto& child : gateChilds[i])
+		{
+			if(child.first == JOURNAL_GATE)
+			{
+				Gate* g = gates.value(child.second);
+				if(g && g != gateParams[i].first) list << g;
+			}
+			else if(child.first == JOURNAL_EVENT)
+			{
+				Event* evt = events.value(child.second);
+				if(evt) list << new Container(evt);
+			}
+			else if(child.first == JOURNAL_TRANSFERT)
+			{
+				Transfert* transfert = new Transfert();
+				transfert->setLink(trees.value(child.second));
+				list << transfert;
+			}
+		}
+		newChilds << list;
+	}
+
+	QList<Node*> dead;
+	QList<Gate*> rebuilt = oldGates;
+	for(auto& gp : gateParams) rebuilt << gp.first;
+	for(Gate* g : rebuilt)
+	{
+		for(Node* c : QList<Node*>(g->getChildren()))
+		{
+			c->detach();
+			if(!dynamic_cast<Gate*>(c)) dead << c;
+		}
+	}
+	for(Gate* g : oldGates) g->detach();
+	for(int i = 0; i < gateParams.size(); i++)
+	{
+		Gate* g = gateParams[i].first;
+		for(Node* c : newChilds[i])
+		{
+			c->detach();
+			c->attach(g);
+		}
+		//le sous-arbre d'un VotingOR dépend de ses fils
+		if(auto v = dynamic_cast<VotingOR*>(g)) v->setK(gateParams[i].second);
+		else if(auto inhibit = dynamic_cast<Inhibit*>(g)) inhibit->setCondition(gateParams[i].second);
+	}
+	for(Node* c : dead)
+		c->remove();
+
+	for(auto& ed : eventDistribs)
+		ed.first->setDistribution(distribs.value(ed.second));
+	for(auto& tt : treeTops)
+		tt.first->setTop(gates.value(tt.second));
+
+	//suppression des objets retirés
+	for(Gate* g : oldGates)
+	{
+		for(Tree& t : e->getTrees())
+			if(t.getTop() == g) t.setTop(nullptr);
+		e->getGates().removeOne(g);
+		e->removeName(g->getProperties().getName());
+		delete g;
+	}
+	for(Tree* t : oldTrees)
+	{
+		t->setTop(nullptr);
+		for(Gate* g : e->getGates())
+			for(Node* n : g->getChildren())
+				if(auto transfert = dynamic_cast<Transfert*>(n))
+					if(transfert->getLink() == t) transfert->setLink(nullptr);
+		e->removeName(t->getProperties().getName());
+		QList<Tree>& ltrees = e->getTrees();
+		for(int i = 0; i < ltrees.size(); i++)
+			if(&ltrees[i] == t) { ltrees.removeAt(i); break; }
+	}
+	for(Event* evt : oldEvents)
+	{
+		evt->setDistribution(nullptr);
+		e->removeName(evt->getProperties().getName());
+		QList<Event>& levents = e->getEvents();
+		for(int i = 0; i < levents.size(); i++)
+			if(&levents[i] == evt) { levents.removeAt(i); break; }
+	}
+	for(Distribution* d : oldDistribs)
+	{
+		for(Event& evt : e->getEvents())
+			if(evt.getDistribution() == d) evt.setDistribution(nullptr);
+		e->getDistributions().removeOne(d);
+		e->removeName(d->getProperties().getName());
+		delete d;
+	}
+}
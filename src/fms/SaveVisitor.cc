@@ -9,77 +9,70 @@ inline bool instanceof(const T* a) {
 	return dynamic_cast<const Base*>(a) != nullptr;
 }
 
-SaveVisitor::SaveVisitor() {}
+// Les éléments sont écrits dans le fichier au fil de la visite, sans construire de document
+SaveVisitor::SaveVisitor(QIODevice* device) : xml(device)
+{
+	xml.setAutoFormatting(true);
+	xml.setAutoFormattingIndent(4);
+}
 
 SaveVisitor::~SaveVisitor() {}
 
-void SaveVisitor::setTreeElem(QDomElement elem) { treeElem = elem; }
+QXmlStreamWriter& SaveVisitor::getWriter() { return xml; }
 
-QDomDocument& SaveVisitor::getDomFile() { return dom; }
-
-void SaveVisitor::writeNameLabel(QDomElement &elem, Properties& prop)
+void SaveVisitor::writeNameLabel(Properties& prop)
 {
-	elem.setAttribute("name", prop.getName());
-	QDomElement tag, attrs;
+	xml.writeAttribute("name", prop.getName());
 	if(!prop.getDesc().isEmpty())
-	{
-		tag = dom.createElement("label");
-		tag.appendChild(dom.createTextNode(prop.getDesc()));
-		elem.appendChild(tag);
-	}
+		xml.writeTextElement("label", prop.getDesc());
 }
 
-void SaveVisitor::writeKeep(QDomElement &propelem, Properties& prop)
+void SaveVisitor::writeKeep(Properties& prop)
 {
-	QDomElement tag = dom.createElement("attribute");
-	tag.setAttribute("name", "keep");
-	tag.setAttribute("value", prop.getKeep() ? "true" : "false");
-	propelem.appendChild(tag);
+	xml.writeEmptyElement("attribute");
+	xml.writeAttribute("name", "keep");
+	xml.writeAttribute("value", prop.getKeep() ? "true" : "false");
 }
 
-void SaveVisitor::writeTypeDistrib(QDomElement &node, QString type)
+void SaveVisitor::writeTypeDistrib(QString type)
 {
-	QDomElement typelem = dom.createElement("attribute");
-	typelem.setAttribute("name", "type");
-	typelem.setAttribute("value", type);
-	node.appendChild(typelem);
+	xml.writeEmptyElement("attribute");
+	xml.writeAttribute("name", "type");
+	xml.writeAttribute("value", type);
 }
 
-void SaveVisitor::writeChildren(QDomElement &node, Gate& gate)
+void SaveVisitor::writeChildren(Gate& gate)
 {
-	QDomElement tmp;
 	for(Node* c : gate.getChildren())
 	{
 		if(instanceof<Gate>(c))
 		{
-			tmp = dom.createElement("gate");
-			tmp.setAttribute("name", (dynamic_cast<Gate*>(c))->getProperties().getName());
+			xml.writeEmptyElement("gate");
+			xml.writeAttribute("name", (dynamic_cast<Gate*>(c))->getProperties().getName());
 		}
 		else if(instanceof<Container>(c))
 		{
-			tmp = dom.createElement("basic-event");
-			tmp.setAttribute("name", (dynamic_cast<Container*>(c))->getEvent()->getProperties().getName());
+			xml.writeEmptyElement("basic-event");
+			xml.writeAttribute("name", (dynamic_cast<Container*>(c))->getEvent()->getProperties().getName());
 		}
 		else if(instanceof<Transfert>(c))
 		{
-			tmp = dom.createElement("gate");
+			xml.writeEmptyElement("gate");
 			Transfert* transfert = dynamic_cast<Transfert*>(c);
 			if(transfert != nullptr && transfert->getLink() != nullptr)
-				tmp.setAttribute("name", transfert->getLink()->getProperties().getName());
+				xml.writeAttribute("name", transfert->getLink()->getProperties().getName());
 		}
-		node.appendChild(tmp);
 	}
 }
 
 void SaveVisitor::writeGate(Gate& gate, QString type)
 {
-	QDomElement rootgate = dom.createElement("define-gate");
-	Properties& prop = gate.getProperties();
-	writeNameLabel(rootgate, prop);
-	QDomElement node = dom.createElement(type);
-	rootgate.appendChild(node);
-	writeChildren(node, gate);
-	treeElem.appendChild(rootgate);
+	xml.writeStartElement("define-gate");
+	writeNameLabel(gate.getProperties());
+	xml.writeStartElement(type);
+	writeChildren(gate);
+	xml.writeEndElement();
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( And &andgate ) { writeGate(andgate, "and"); }
@@ -90,107 +83,83 @@ void SaveVisitor::visit( Xor &xorgate ) { writeGate(xorgate, "xor"); }
 
 void SaveVisitor::visit( VotingOR &vorgate )
 { 
-	QDomElement rootgate = dom.createElement("define-gate");
-	Properties& prop = vorgate.getProperties();
-	writeNameLabel(rootgate, prop);
-	QDomElement node = dom.createElement("atleast");
-	node.setAttribute("min", vorgate.getK());
-	rootgate.appendChild(node);
-	writeChildren(node, vorgate);
-	treeElem.appendChild(rootgate);
+	xml.writeStartElement("define-gate");
+	writeNameLabel(vorgate.getProperties());
+	xml.writeStartElement("atleast");
+	xml.writeAttribute("min", QString::number(vorgate.getK()));
+	writeChildren(vorgate);
+	xml.writeEndElement();
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( Inhibit &inhibgate )
 {
-	QDomElement rootgate = dom.createElement("define-gate");
-	Properties& prop = inhibgate.getProperties();
-	writeNameLabel(rootgate, prop);
-	QDomElement node = dom.createElement("and");
-	QDomElement tmp;
-	tmp = dom.createElement("constant");
-	tmp.setAttribute("value", inhibgate.getCondition() ? "true" : "false");
-	node.appendChild(tmp);
-	writeChildren(node, inhibgate);
-	rootgate.appendChild(node);
-	treeElem.appendChild(rootgate);
+	xml.writeStartElement("define-gate");
+	writeNameLabel(inhibgate.getProperties());
+	xml.writeStartElement("and");
+	xml.writeEmptyElement("constant");
+	xml.writeAttribute("value", inhibgate.getCondition() ? "true" : "false");
+	writeChildren(inhibgate);
+	xml.writeEndElement();
+	xml.writeEndElement();
+}
+
+// Ouvre un define-parameter, les valeurs sont écrites par l'appelant
+void SaveVisitor::writeDistrib(Distribution& distrib, QString type)
+{
+	Properties& prop = distrib.getProperties();
+	xml.writeStartElement("define-parameter");
+	writeNameLabel(prop);
+	xml.writeStartElement("attributes");
+	writeKeep(prop);
+	writeTypeDistrib(type);
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( Constant &constdistrib )
 {
-	QDomElement distr = dom.createElement("define-parameter");
-	Properties& prop = constdistrib.getProperties();
-	distr.setAttribute("name", prop.getName());
-
-	QDomElement propelem = dom.createElement("attributes");
-	writeNameLabel(distr, prop);
-	writeKeep(propelem, prop);
-	writeTypeDistrib(propelem, "const");
-	distr.appendChild(propelem);
-
-	QDomElement val = dom.createElement("float");
-	val.setAttribute("value", doubleToString(constdistrib.getValue()));
-	distr.appendChild(val);
-	dom.documentElement().appendChild(distr);
+	writeDistrib(constdistrib, "const");
+	xml.writeEmptyElement("float");
+	xml.writeAttribute("value", doubleToString(constdistrib.getValue()));
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( Exponential &expdistrib )
 {
 	//Même nombre de valeur
-	QDomElement distr = dom.createElement("define-parameter");
-	Properties& prop = expdistrib.getProperties();
-	distr.setAttribute("name", prop.getName());
-
-	QDomElement propelem = dom.createElement("attributes");
-	writeNameLabel(distr, prop);
-	writeKeep(propelem, prop);
-	writeTypeDistrib(propelem, "exp");
-	distr.appendChild(propelem);
-
-	QDomElement val = dom.createElement("float");
-	val.setAttribute("value", doubleToString(expdistrib.getValue()));
-	distr.appendChild(val);
-	dom.documentElement().appendChild(distr);
+	writeDistrib(expdistrib, "exp");
+	xml.writeEmptyElement("float");
+	xml.writeAttribute("value", doubleToString(expdistrib.getValue()));
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( Weibull &weibulldistrib )
 {
-	QDomElement distr = dom.createElement("define-parameter");
-	Properties& prop = weibulldistrib.getProperties();
-	QDomElement propelem = dom.createElement("attributes");
-	writeNameLabel(distr, prop);
-	writeKeep(propelem, prop);
-	writeTypeDistrib(propelem, "weibull");
-	distr.appendChild(propelem);
-
-	QDomElement val;
-	val = dom.createElement("float");
-	val.setAttribute("value", doubleToString(weibulldistrib.getScale()));
-	distr.appendChild(val);
-	val = dom.createElement("float");
-	val.setAttribute("value", doubleToString(weibulldistrib.getShape()));
-	distr.appendChild(val);
-	dom.documentElement().appendChild(distr);
+	writeDistrib(weibulldistrib, "weibull");
+	xml.writeEmptyElement("float");
+	xml.writeAttribute("value", doubleToString(weibulldistrib.getScale()));
+	xml.writeEmptyElement("float");
+	xml.writeAttribute("value", doubleToString(weibulldistrib.getShape()));
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( Event &event )
 {
-	QDomElement tag, tag2;
 	Properties& prop = event.getProperties(); 
-	tag = dom.createElement("define-basic-event");
-	QDomElement propelem = dom.createElement("attributes");
-	writeNameLabel(tag, prop);
-	writeKeep(propelem, prop);
-	tag.appendChild(propelem);
+	xml.writeStartElement("define-basic-event");
+	writeNameLabel(prop);
+	xml.writeStartElement("attributes");
+	writeKeep(prop);
+	xml.writeEndElement();
 	
 	// wrtie parameter if any
 	Distribution* distr = event.getDistribution();
 	if(distr)
 	{
-		tag2 = dom.createElement("parameter");
-		tag2.setAttribute("name", distr->getProperties().getName());
-		tag.appendChild(tag2);
+		xml.writeEmptyElement("parameter");
+		xml.writeAttribute("name", distr->getProperties().getName());
 	}
-	dom.documentElement().appendChild(tag);
+	xml.writeEndElement();
 }
 
 void SaveVisitor::visit( Transfert &transfertgate ) { (void)transfertgate; }
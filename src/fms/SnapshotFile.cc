@@ -0,0 +1,356 @@
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QVector>
+#include <cstring>
+#include "SnapshotFile.hh"
+
+// Layout: header, string offsets, string characters, then one flat array per kind of object
+// Every section starts on 8 bytes so that the arrays can be read in place from the mapped file
+// Objects refer to each other, and to their names and labels, by index
+
+#define SNAP_MAGIC		0x50414e53 // "SNAP" in little endian, a file of the other endianness is rejected
+#define SNAP_VERSION	1
+
+enum { SNAP_CONSTANT, SNAP_EXPONENTIAL, SNAP_WEIBULL };
+enum { SNAP_AND, SNAP_OR, SNAP_XOR, SNAP_VOTINGOR, SNAP_INHIBIT };
+enum { SNAP_GATE, SNAP_EVENT, SNAP_TRANSFERT };
+
+struct SnapHeader
+{
+	quint32	magic;
+	quint32	version;
+	qint64	xmlSize;
+	qint64	xmlTime;
+	qint32	nbStrings;
+	qint32	nbChars;
+	qint32	nbDistribs;
+	qint32	nbEvents;
+	qint32	nbGates;
+	qint32	nbChilds;
+	qint32	nbTrees;
+	qint32	unused;
+};
+
+struct SnapDistrib
+{
+	qint32	type;
+	qint32	name;
+	qint32	desc;
+	qint32	keep;
+	double	value;
+	double	shape;
+};
+
+struct SnapEvent
+{
+	qint32	name;
+	qint32	desc;
+	qint32	keep;
+	qint32	distrib; // -1 if none
+};
+
+struct SnapGate
+{
+	qint32	type;
+	qint32	name;
+	qint32	desc;
+	qint32	keep;
+	qint32	param; // k of VotingOR, condition of Inhibit
+	qint32	firstChild;
+	qint32	nbChilds;
+	qint32	unused;
+};
+
+struct SnapChild
+{
+	qint32	kind;
+	qint32	index; // gate, event or linked tree (-1 if none)
+};
+
+struct SnapTree
+{
+	qint32	name;
+	qint32	desc;
+	qint32	keep;
+	qint32	top; // -1 if none
+};
+
+static_assert(sizeof(SnapHeader) % 8 == 0 && sizeof(SnapDistrib) % 8 == 0 && sizeof(SnapEvent) % 8 == 0
+&& sizeof(SnapGate) % 8 == 0 && sizeof(SnapChild) % 8 == 0 && sizeof(SnapTree) % 8 == 0, "misaligned snapshot section");
+
+static qint64 align(qint64 size)
+{
+	return (size + 7) & ~7LL;
+}
+
+SnapshotFile::SnapshotFile(QString xmlPath, QString path) :
+xmlPath(xmlPath), path(path.isEmpty() ? xmlPath + ".snap" : path) {}
+
+SnapshotFile::~SnapshotFile() {}
+
+QString SnapshotFile::getPath() { return path; }
+
+Editor* SnapshotFile::read()
+{
+	QFile file(path);
+	if(!QFileInfo::exists(xmlPath) || !file.open(QIODevice::ReadOnly))
+		return nullptr;
+	uchar* data = file.map(0, file.size());
+	if(!data)
+		return nullptr;
+	Editor* editor = nullptr;
+	try { editor = parse(data, file.size()); }
+	catch(int exp) { editor = nullptr; }
+	file.unmap(data);
+	return editor;
+}
+
+Editor* SnapshotFile::parse(const uchar* data, qint64 size)
+{
+	SnapHeader h;
+	if(size < (qint64)sizeof(h)) throw -1;
+	std::memcpy(&h, data, sizeof(h));
+
+	QFileInfo info(xmlPath);
+	if(h.magic != SNAP_MAGIC || h.version != SNAP_VERSION
+	|| h.xmlSize != info.size() || h.xmlTime != info.lastModified().toMSecsSinceEpoch())
+		throw -1;
+	if(h.nbStrings < 0 || h.nbChars < 0 || h.nbDistribs < 0 || h.nbEvents < 0
+	|| h.nbGates < 0 || h.nbChilds < 0 || h.nbTrees < 0)
+		throw -1;
+
+	qint64 offset = sizeof(h);
+	const quint32* offs = (const quint32*)(data + offset);
+	offset += align((h.nbStrings + 1LL) * sizeof(quint32));
+	const QChar* chars = (const QChar*)(data + offset);
+	offset += align(h.nbChars * 2LL);
+	const SnapDistrib* distribs = (const SnapDistrib*)(data + offset);
+	offset += h.nbDistribs * (qint64)sizeof(SnapDistrib);
+	const SnapEvent* events = (const SnapEvent*)(data + offset);
+	offset += h.nbEvents * (qint64)sizeof(SnapEvent);
+	const SnapGate* gates = (const SnapGate*)(data + offset);
+	offset += h.nbGates * (qint64)sizeof(SnapGate);
+	const SnapChild* childs = (const SnapChild*)(data + offset);
+	offset += h.nbChilds * (qint64)sizeof(SnapChild);
+	const SnapTree* trees = (const SnapTree*)(data + offset);
+	offset += h.nbTrees * (qint64)sizeof(SnapTree);
+	if(offset != size) throw -1;
+
+	QVector<QString> strings(h.nbStrings);
+	for(int i = 0; i < h.nbStrings; i++)
+	{
+		if(offs[i] > offs[i + 1] || offs[i + 1] > (quint32)h.nbChars) throw -1;
+		strings[i] = QString(chars + offs[i], offs[i + 1] - offs[i]);
+	}
+	auto str = [&strings](qint32 i) -> const QString& {
+		if(i < 0 || i >= strings.size()) throw -1;
+		return strings[i];
+	};
+
+	Editor* e = new Editor(false);
+	try
+	{
+		auto declare = [e](Properties& prop, const QString& desc, bool keep) {
+			if(!e->isUnique(prop.getName())) throw -1;
+			e->addName(prop.getName());
+			prop.setDesc(desc);
+			prop.setKeep(keep);
+		};
+
+		QList<Distribution*>& ldistribs = e->getDistributions();
+		for(int i = 0; i < h.nbDistribs; i++)
+		{
+			const SnapDistrib& s = distribs[i];
+			Distribution* d;
+			if(s.type == SNAP_CONSTANT) d = new Constant(str(s.name));
+			else if(s.type == SNAP_EXPONENTIAL) d = new Exponential(str(s.name));
+			else if(s.type == SNAP_WEIBULL) d = new Weibull(str(s.name));
+			else throw -1;
+			ldistribs << d;
+			declare(d->getProperties(), str(s.desc), s.keep);
+			d->setValue(s.value);
+			if(s.type == SNAP_WEIBULL) ((Weibull*)d)->setShape(s.shape);
+		}
+
+		QList<Event>& levents = e->getEvents();
+		for(int i = 0; i < h.nbEvents; i++)
+		{
+			const SnapEvent& s = events[i];
+			levents << Event(str(s.name));
+			declare(levents.last().getProperties(), str(s.desc), s.keep);
+			if(s.distrib >= h.nbDistribs) throw -1;
+			if(s.distrib >= 0) levents.last().setDistribution(ldistribs[s.distrib]);
+		}
+
+		QList<Tree>& ltrees = e->getTrees();
+		for(int i = 0; i < h.nbTrees; i++)
+		{
+			ltrees << Tree(str(trees[i].name));
+			declare(ltrees.last().getProperties(), str(trees[i].desc), trees[i].keep);
+		}
+
+		//les portes sont créées avant d'être liées, comme dans XmlTreeReader
+		QList<Gate*>& lgates = e->getGates();
+		for(int i = 0; i < h.nbGates; i++)
+		{
+			const SnapGate& s = gates[i];
+			Gate* g;
+			if(s.type == SNAP_AND) g = new And(str(s.name));
+			else if(s.type == SNAP_OR) g = new Or(str(s.name));
+			else if(s.type == SNAP_XOR) g = new Xor(str(s.name));
+			else if(s.type == SNAP_VOTINGOR) { g = new VotingOR(str(s.name)); ((VotingOR*)g)->setK(s.param); }
+			else if(s.type == SNAP_INHIBIT) { g = new Inhibit(str(s.name)); ((Inhibit*)g)->setCondition(s.param); }
+			else throw -1;
+			lgates << g;
+			declare(g->getProperties(), str(s.desc), s.keep);
+		}
+
+		for(int i = 0; i < h.nbGates; i++)
+		{
+			const SnapGate& s = gates[i];
+			if(s.firstChild < 0 || s.nbChilds < 0 || (qint64)s.firstChild + s.nbChilds > h.nbChilds) throw -1;
+			for(int j = s.firstChild; j < s.firstChild + s.nbChilds; j++)
+			{
+				const SnapChild& c = childs[j];
+				if(c.kind == SNAP_GATE)
+				{
+					if(c.index < 0 || c.index >= h.nbGates || c.index == i || lgates[c.index]->getParent()) throw -1;
+					lgates[c.index]->attach(lgates[i]);
+				}
+				else if(c.kind == SNAP_EVENT)
+				{
+					if(c.index < 0 || c.index >= h.nbEvents) throw -1;
+					(new Container(&levents[c.index]))->attach(lgates[i]);
+				}
+				else if(c.kind == SNAP_TRANSFERT)
+				{
+					if(c.index >= h.nbTrees) throw -1;
+					Transfert* transfert = new Transfert();
+					transfert->attach(lgates[i]);
+					if(c.index >= 0) transfert->setLink(&ltrees[c.index]);
+				}
+				else throw -1;
+			}
+		}
+
+		for(int i = 0; i < h.nbTrees; i++)
+		{
+			if(trees[i].top >= h.nbGates) throw -1;
+			if(trees[i].top >= 0) ltrees[i].setTop(lgates[trees[i].top]);
+		}
+	}
+	catch(int exp)
+	{
+		delete e;
+		throw;
+	}
+	return e;
+}
+
+bool SnapshotFile::write(Editor* editor)
+{
+	QFileInfo info(xmlPath);
+	if(!info.exists())
+		return false;
+
+	QVector<QString> strings;
+	QHash<QString, int> stringIndex;
+	auto str = [&strings, &stringIndex](const QString& s) {
+		auto it = stringIndex.constFind(s);
+		if(it != stringIndex.constEnd()) return it.value();
+		stringIndex.insert(s, strings.size());
+		strings << s;
+		return strings.size() - 1;
+	};
+
+	QList<Distribution*>& ldistribs = editor->getDistributions();
+	QList<Event>& levents = editor->getEvents();
+	QList<Gate*>& lgates = editor->getGates();
+	QList<Tree>& ltrees = editor->getTrees();
+	QHash<Distribution*, int> distribIndex;
+	QHash<Event*, int> eventIndex;
+	QHash<Gate*, int> gateIndex;
+	QHash<Tree*, int> treeIndex;
+	for(int i = 0; i < ldistribs.size(); i++) distribIndex.insert(ldistribs[i], i);
+	for(int i = 0; i < levents.size(); i++) eventIndex.insert(&levents[i], i);
+	for(int i = 0; i < lgates.size(); i++) gateIndex.insert(lgates[i], i);
+	for(int i = 0; i < ltrees.size(); i++) treeIndex.insert(&ltrees[i], i);
+
+	QVector<SnapDistrib> distribs;
+	for(Distribution* d : ldistribs)
+	{
+		Properties& prop = d->getProperties();
+		SnapDistrib s = {SNAP_CONSTANT, str(prop.getName()), str(prop.getDesc()), prop.getKeep(), d->getValue(), 0};
+		if(dynamic_cast<Exponential*>(d)) s.type = SNAP_EXPONENTIAL;
+		else if(auto w = dynamic_cast<Weibull*>(d)) { s.type = SNAP_WEIBULL; s.shape = w->getShape(); }
+		distribs << s;
+	}
+
+	QVector<SnapEvent> events;
+	for(Event& evt : levents)
+	{
+		Properties& prop = evt.getProperties();
+		events << SnapEvent{str(prop.getName()), str(prop.getDesc()), prop.getKeep(), distribIndex.value(evt.getDistribution(), -1)};
+	}
+
+	QVector<SnapGate> gates;
+	QVector<SnapChild> childs;
+	for(Gate* g : lgates)
+	{
+		Properties& prop = g->getProperties();
+		SnapGate s = {SNAP_AND, str(prop.getName()), str(prop.getDesc()), prop.getKeep(), 0, childs.size(), g->getChildren().size(), 0};
+		if(dynamic_cast<Or*>(g)) s.type = SNAP_OR;
+		else if(dynamic_cast<Xor*>(g)) s.type = SNAP_XOR;
+		else if(auto v = dynamic_cast<VotingOR*>(g)) { s.type = SNAP_VOTINGOR; s.param = v->getK(); }
+		else if(auto inhibit = dynamic_cast<Inhibit*>(g)) { s.type = SNAP_INHIBIT; s.param = inhibit->getCondition(); }
+		gates << s;
+		for(Node* n : g->getChildren())
+		{
+			SnapChild c = {SNAP_GATE, -1};
+			if(auto gg = dynamic_cast<Gate*>(n)) c.index = gateIndex.value(gg, -1);
+			else if(auto cont = dynamic_cast<Container*>(n)) { c.kind = SNAP_EVENT; c.index = eventIndex.value(cont->getEvent(), -1); }
+			else if(auto transfert = dynamic_cast<Transfert*>(n)) { c.kind = SNAP_TRANSFERT; c.index = treeIndex.value(transfert->getLink(), -1); }
+			if(c.index == -1 && c.kind != SNAP_TRANSFERT) return false; // objet hors de l'éditeur
+			childs << c;
+		}
+	}
+
+	QVector<SnapTree> trees;
+	for(Tree& t : ltrees)
+	{
+		Properties& prop = t.getProperties();
+		trees << SnapTree{str(prop.getName()), str(prop.getDesc()), prop.getKeep(), gateIndex.value(t.getTop(), -1)};
+	}
+
+	QVector<quint32> offs;
+	QString chars;
+	for(const QString& s : strings)
+	{
+		offs << chars.size();
+		chars += s;
+	}
+	offs << chars.size();
+
+	SnapHeader h = {SNAP_MAGIC, SNAP_VERSION, info.size(), info.lastModified().toMSecsSinceEpoch(), strings.size(), chars.size(),
+	distribs.size(), events.size(), gates.size(), childs.size(), trees.size(), 0};
+
+	QSaveFile file(path);
+	if(!file.open(QIODevice::WriteOnly))
+		return false;
+	QByteArray pad(8, 0);
+	qint64 n = offs.size() * sizeof(quint32);
+	file.write((const char*)&h, sizeof(h));
+	file.write((const char*)offs.constData(), n);
+	file.write(pad.constData(), align(n) - n);
+	n = chars.size() * 2LL;
+	file.write((const char*)chars.constData(), n);
+	file.write(pad.constData(), align(n) - n);
+	file.write((const char*)distribs.constData(), distribs.size() * sizeof(SnapDistrib));
+	file.write((const char*)events.constData(), events.size() * sizeof(SnapEvent));
+	file.write((const char*)gates.constData(), gates.size() * sizeof(SnapGate));
+	file.write((const char*)childs.constData(), childs.size() * sizeof(SnapChild));
+	file.write((const char*)trees.constData(), trees.size() * sizeof(SnapTree));
+	return file.commit();
+}
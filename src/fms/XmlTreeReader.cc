@@ -1,278 +1,280 @@
 #include "XmlTreeReader.hh"
 
-XmlTreeReader::XmlTreeReader(Editor* e, QDomDocument &d) :  dom(d), e(e) , nodelistcursor(0) {}
+XmlTreeReader::XmlTreeReader(Editor* e, QIODevice* device) :  xml(device), e(e) {}
 
 XmlTreeReader::~XmlTreeReader() {}
 
+// Lecture en un seul passage: les références (distributions, portes, transferts) sont résolues à la fin
 void XmlTreeReader::read()
 {
-	QList<QDomElement> lparams;
-	QList<QDomElement> ltree;
-	QList<QDomElement> levents;
-	
-	QDomElement root=dom.documentElement();
-
-	QDomNodeList childs = root.childNodes();
-	for(int i=0; i<childs.size(); i++)
+	if(!xml.readNextStartElement()) throw -1;
+
+	while(xml.readNextStartElement())
 	{
-		QDomElement elem = childs.at(i).toElement();
-		QString tagname = elem.tagName();
-		if(tagname == "define-parameter") lparams << elem;
-		else if(tagname == "define-basic-event") levents << elem;
-		else if(tagname == "define-fault-tree") ltree << elem;
+		if(xml.name() == "define-parameter") readDistrib();
+		else if(xml.name() == "define-basic-event") readEvent();
+		else if(xml.name() == "define-fault-tree") readTree();
+		else xml.skipCurrentElement();
+	}
+	while(!xml.atEnd()) xml.readNext();
+	if(xml.hasError()) throw -1;
+
+	//association des events avec leur distribution
+	for(int i : eventDistribMap.keys())
+	{
+		Distribution* d = distribIndex.value(eventDistribMap[i]);
+		if(!d) throw -1;
+		e->getEvents()[i].setDistribution(d);
+	}
+	//liaison des portes à leurs fils, un arbre ne voit que ses portes et celles des arbres précédents
+	int begin = 0;
+	for(int end : treeGateEnds)
+	{
+		for(int i = begin; i < end; i++)
+			readGateChilds(e->getGates()[i], gateChilds[i], end);
+		begin = end;
 	}
-	
-	for(QDomElement& e : lparams)
-		readDistrib(e);
-	for(QDomElement& e : levents)
-		readEvent(e);
-	for(QDomElement& e : ltree)
-		readTree(e);
 	//association des transfert avec les Trees de même nom
 	for(Transfert* transfert : transtreeMap.keys())
 	{
-		for(Tree &t : e->getTrees())
-		{
-			if(t.getProperties().getName() == transtreeMap[transfert])
-			{
-				transfert->setLink(&t);
-				break;
-			}
-		}
-		if(!transfert->getLink()) throw -1;
+		int tree = treeIndex.value(transtreeMap[transfert], -1);
+		if(tree == -1) throw -1;
+		transfert->setLink(&e->getTrees()[tree]);
 	}
 	//add a tree if there is none
-	if(ltree.isEmpty()) e->getTrees() << Tree(e->generateName(PREFIX_TREE));
+	if(treeGateEnds.isEmpty())
+	{
+		e->getTrees() << Tree(e->generateName(PREFIX_TREE));
+		e->addName(e->getTrees().last().getProperties().getName());
+	}
 }
 
-void XmlTreeReader::readTree(QDomElement &elem)
+void XmlTreeReader::declare(const QString& name)
 {
-	QList<QDomNodeList> lgates;
-	QString name, type, topevt;
-	
-	name = elem.attribute("name").trimmed();
 	if(!e->isUnique(name)) throw -1;
+	e->addName(name);
+}
 
-	QDomNodeList attrs = elem.namedItem("attributes").childNodes();
-
-	for(int i=0; i < attrs.size(); i++)
+void XmlTreeReader::readAttributes(QMap<QString, QString>& attrs)
+{
+	while(xml.readNextStartElement())
 	{
-		QDomElement attr = attrs.at(i).toElement();
-		if(attr.tagName() != "attribute") throw -1;
-		QString attrname = attr.attribute("name").trimmed();
+		if(xml.name() != "attribute") throw -1;
+		QString attrname = xml.attributes().value("name").toString().trimmed();
 		if(attrname.isEmpty()) throw -1;
-		if(attrname == "top-event") topevt = attr.attribute("value").trimmed();
+		attrs.insert(attrname, xml.attributes().value("value").toString().trimmed());
+		xml.skipCurrentElement();
 	}
-	
+}
+
+QString XmlTreeReader::readLabel()
+{
+	return xml.readElementText(QXmlStreamReader::IncludeChildElements).trimmed();
+}
+
+void XmlTreeReader::readTree()
+{
+	QMap<QString, QString> attrs;
+	QString desc;
+	bool haslabel = false;
+
+	QString name = xml.attributes().value("name").toString().trimmed();
+	declare(name);
+
 	e->getTrees() << Tree(name);
-	Tree &t = e->getTrees().last();
-	t.getProperties().setDesc(elem.namedItem("label").toElement().text().trimmed());
-	t.getProperties().setKeep(true);
+	int tree = e->getTrees().size() - 1;
+	treeIndex.insert(name, tree);
+	int begin = e->getGates().size();
 
-	//visit des gate pour les créer
-	QDomElement elmgate = elem.namedItem("define-gate").toElement();
-	unsigned nbgates = 0;
-	while(!elmgate.isNull())
+	//création des portes, les fils sont liés à la fin de la lecture
+	while(xml.readNextStartElement())
 	{
-		Gate* g = readGateParams(elmgate, lgates);
-		if(g->getProperties().getName() == topevt)
+		if(xml.name() == "attributes") readAttributes(attrs);
+		else if(xml.name() == "label" && !haslabel) { desc = readLabel(); haslabel = true; }
+		else if(xml.name() == "define-gate")
 		{
-			t.setTop(g);
+			QList<ChildRef> childs;
+			Gate* g = readGateParams(childs);
+			gateIndex.insert(g->getProperties().getName(), e->getGates().size());
+			e->getGates() << g; // ajout de la porte à l'éditeur
+			gateChilds << childs;
 		}
-		nbgates++;
-		e->getGates() <<  g; // ajout de la porte à l'éditeur
-		elmgate = elmgate.nextSiblingElement("define-gate");
-	}
-	//visit pour les lier à leur fils
-	
-	for(int i=0; i < lgates.size(); i++)
-	{
-		readGateChilds(e->getGates()[nodelistcursor+i], lgates.at(i));
+		else xml.skipCurrentElement();
 	}
-	nodelistcursor += nbgates;
+
+	Tree &t = e->getTrees()[tree];
+	t.getProperties().setDesc(desc);
+	t.getProperties().setKeep(true);
+
+	int top = gateIndex.value(attrs.value("top-event"), -1);
+	if(top >= begin) t.setTop(e->getGates()[top]);
+	treeGateEnds << e->getGates().size();
 }
 
-void XmlTreeReader::readDistrib(QDomElement &elem)
+void XmlTreeReader::readDistrib()
 {
 	Distribution *d = nullptr;
-	QString name, type;
-	bool keep = false;
-	
-	name = elem.attribute("name").trimmed();
-	if(!e->isUnique(name)) throw -1;
+	QMap<QString, QString> attrs;
+	QList<double> values;
+	QString desc;
+	bool haslabel = false;
 
-	QDomNodeList attrs = elem.namedItem("attributes").childNodes();
+	QString name = xml.attributes().value("name").toString().trimmed();
+	declare(name);
 
-	for(int i=0; i < attrs.size(); i++)
+	while(xml.readNextStartElement())
 	{
-		QDomElement attr = attrs.at(i).toElement();
-		if(attr.tagName() != "attribute") throw -1;
-		QString attrname = attr.attribute("name").trimmed();
-		if(attrname.isEmpty()) throw -1;
-		
-		if(attrname == "keep") keep = attr.attribute("value").trimmed() == "true";
-		else if(attrname == "type") type = attr.attribute("value").trimmed();
+		if(xml.name() == "attributes") readAttributes(attrs);
+		else if(xml.name() == "label" && !haslabel) { desc = readLabel(); haslabel = true; }
+		else
+		{
+			if(xml.name() == "float") values << xml.attributes().value("value").toDouble();
+			xml.skipCurrentElement();
+		}
 	}
-	
+
+	QString type = attrs.value("type");
 	if(type == "const") d = new Constant(name);
 	else if(type == "exp") d = new Exponential(name);
 	else if(type == "weibull") d = new Weibull(name);
 	else throw -1;
 
-	d->getProperties().setDesc(elem.namedItem("label").toElement().text().trimmed());
-	d->getProperties().setKeep(keep);
-	
-	QDomElement valelem = elem.firstChildElement("float");
-	d->setValue(valelem.attribute("value").toDouble());
+	d->getProperties().setDesc(desc);
+	d->getProperties().setKeep(attrs.value("keep") == "true");
+
+	d->setValue(values.value(0));
 	if(type == "weibull")
-		(dynamic_cast<Weibull*>(d))->setShape(valelem.nextSiblingElement("float").attribute("value").toDouble());
-	
+		(dynamic_cast<Weibull*>(d))->setShape(values.value(1));
+
 	e->getDistributions() << d;
+	distribIndex.insert(name, d);
 }
 
-void XmlTreeReader::readGateChilds(Gate *g, QDomNodeList list)
+void XmlTreeReader::readGateChilds(Gate *g, QList<ChildRef>& childs, int nbgates)
 {
 	bool ok = false;
-	for(int j=0; j<list.size(); j++)
+	for(ChildRef& child : childs)
 	{
-		QDomElement elem = list.at(j).toElement();
-		QString name = elem.attribute("name").trimmed();
-		
-		if(g->getProperties().getName() == name) throw -1;
-		
-		if(elem.tagName() == "basic-event")
+		if(child.tag == "basic-event")
 		{
-			for(Event &evt : e->getEvents())
+			int evt = eventIndex.value(child.name, -1);
+			if(evt != -1)
 			{
-				if(evt.getProperties().getName() == name)
-				{
-					ok = true;
-					Container* cont = new Container(&evt);
-					cont->attach(g);
-					break;
-				}
+				ok = true;
+				Container* cont = new Container(&e->getEvents()[evt]);
+				cont->attach(g);
 			}
 		}
-		else if(elem.tagName() == "gate")
+		else if(child.name.isEmpty()) { (new Transfert)->attach(g) ; ok = true;}
+		else
 		{
-			if(name.isEmpty()) { (new Transfert)->attach(g) ; ok = true;}
-			else if(!name.isEmpty())
+			int gg = gateIndex.value(child.name, -1);
+			if(gg != -1 && gg < nbgates)
 			{
-				for(Gate* gg : e->getGates())
-				{
-					if(gg->getProperties().getName() == name) 
-					{
-						ok = true;
-						gg->attach(g);
-						break;
-					}
-				}
-				
-				if(ok != true)
-				{
-					//PB: Transfert cherche Tree pas encore chargé
-					//SOLVED: QMap<Transfert*, QString> dans Reader puis recherche parmis les Trees avec la QString
-					ok = true;
-					Transfert* transfert = new Transfert();
-					transfert->attach(g);
-					transtreeMap.insert(transfert, name);
-				}
+				ok = true;
+				e->getGates()[gg]->attach(g);
+			}
+
+			if(ok != true)
+			{
+				//PB: Transfert cherche Tree pas encore chargé
+				//SOLVED: QMap<Transfert*, QString> dans Reader puis recherche parmis les Trees avec la QString
+				ok = true;
+				Transfert* transfert = new Transfert();
+				transfert->attach(g);
+				transtreeMap.insert(transfert, child.name);
 			}
 		}
-		else if(elem.tagName() == "constant") ok = true;
-		
+
 		if(ok == false) {throw -1;}
 		ok = false;
-		
 	}
 }
 
-Gate* XmlTreeReader::readGateParams(QDomElement &elem, QList<QDomNodeList>& lelems)
+Gate* XmlTreeReader::readGateParams(QList<ChildRef>& childs)
 {
 	Gate* g = nullptr;
-	QString type;
-	
-	QString name = elem.attribute("name").trimmed();
-	if(!e->isUnique(name)) throw -1;
-	
-	QDomNodeList attrs = elem.namedItem("attributes").childNodes();
+	QMap<QString, QString> attrs;
+	QString type, desc;
+	bool haslabel = false, hasconst = false, condition = false;
+	double k = 0;
 
-	for(int i=0; i < attrs.size(); i++)
-	{
-		QDomElement attr = attrs.at(i).toElement();
-		if(attr.tagName() != "attribute") throw -1;
-		QString attrname = attr.attribute("name").trimmed();
-		if(attrname.isEmpty()) throw -1;
-	}
-	
-	//get Gate Type
-	QDomNodeList subelem = elem.childNodes();
-	for(int i=0; i<subelem.size(); i++)
+	QString name = xml.attributes().value("name").toString().trimmed();
+	declare(name);
+
+	//get Gate Type, la porte est créée une fois l'élément lu
+	while(xml.readNextStartElement())
 	{
-		QString type = subelem.at(i).nodeName();
-		if(type == "and")
+		if(xml.name() == "attributes") readAttributes(attrs);
+		else if(xml.name() == "label" && !haslabel) { desc = readLabel(); haslabel = true; }
+		else if(type.isEmpty() && (xml.name() == "and" || xml.name() == "or" || xml.name() == "xor" || xml.name() == "atleast"))
 		{
-			QDomNode constnode = subelem.at(i).namedItem("constant");
-			if(!constnode.isNull())
-				{g = new Inhibit(name); ((Inhibit*)g)->setCondition(constnode.toElement().attribute("value").trimmed() == "true");}
-			else g = new And(name);
+			type = xml.name().toString();
+			k = xml.attributes().value("min").toDouble();
+			while(xml.readNextStartElement())
+			{
+				QString tag = xml.name().toString();
+				QString childname = xml.attributes().value("name").toString().trimmed();
+				if(childname == name) throw -1;
+				if(tag == "constant")
+				{
+					if(!hasconst) condition = xml.attributes().value("value").toString().trimmed() == "true";
+					hasconst = true;
+				}
+				else if(tag == "basic-event" || tag == "gate") childs << ChildRef{tag, childname};
+				else throw -1;
+				xml.skipCurrentElement();
+			}
 		}
-		else if(type == "or") g = new Or(name);
-		else if(type == "xor") g = new Xor(name);
-		else if(type == "atleast"){ g = new VotingOR(name); ((VotingOR*)g)->setK(subelem.at(i).toElement().attribute("min").toDouble());}
-		
-		if(g) {lelems << subelem.at(i).childNodes(); break;}
+		else xml.skipCurrentElement();
 	}
 
+	if(type == "and")
+	{
+		if(hasconst) {g = new Inhibit(name); ((Inhibit*)g)->setCondition(condition);}
+		else g = new And(name);
+	}
+	else if(type == "or") g = new Or(name);
+	else if(type == "xor") g = new Xor(name);
+	else if(type == "atleast"){ g = new VotingOR(name); ((VotingOR*)g)->setK(k);}
+
 	if(!g) throw -1;
 	g->getProperties().setKeep(true);
-	g->getProperties().setDesc(elem.namedItem("label").toElement().text().trimmed());
-	
+	g->getProperties().setDesc(desc);
+
 	return g;
 }
 
-void XmlTreeReader::readEvent(QDomElement &elem)
+void XmlTreeReader::readEvent()
 {
-	bool keep = false;
+	QMap<QString, QString> attrs;
+	QString desc, namedst;
+	bool haslabel = false, hasparam = false;
 
-	QString name = elem.attribute("name").trimmed();
-	if(!e->isUnique(name)) throw -1;
-	
-	QDomNodeList attrs = elem.namedItem("attributes").childNodes();
+	QString name = xml.attributes().value("name").toString().trimmed();
+	declare(name);
 
-	for(int i=0; i < attrs.size(); i++)
+	while(xml.readNextStartElement())
 	{
-		QDomElement attr = attrs.at(i).toElement();
-		if(attr.tagName() != "attribute") throw -1;
-		QString attrname = attr.attribute("name").trimmed();
-		if(attrname.isEmpty()) throw -1;
-		if(attrname == "keep") keep = attr.attribute("value").trimmed() == "true";
+		if(xml.name() == "attributes") readAttributes(attrs);
+		else if(xml.name() == "label" && !haslabel) { desc = readLabel(); haslabel = true; }
+		else
+		{
+			if(xml.name() == "parameter" && !hasparam)
+			{
+				namedst = xml.attributes().value("name").toString().trimmed();
+				hasparam = true;
+			}
+			xml.skipCurrentElement();
+		}
 	}
-	
-	QList<Distribution*> ldistribs = e->getDistributions();
 
 	QList<Event>& levents = e->getEvents();
+	eventIndex.insert(name, levents.size());
 	levents << Event(name);
-	levents.last().getProperties().setKeep(keep);
-	levents.last().getProperties().setDesc(elem.namedItem("label").toElement().text().trimmed());
+	levents.last().getProperties().setKeep(attrs.value("keep") == "true");
+	levents.last().getProperties().setDesc(desc);
 
-	QString namedst = elem.namedItem("parameter").toElement().attribute("name").trimmed();
-	int idst;
-	
-	if(!namedst.isEmpty())
-	{
-		idst = searchDistribution(ldistribs, namedst);
-		if(idst == -1) throw -1;
-		levents.last().setDistribution(ldistribs[idst]);
-	}
-}
-
-int XmlTreeReader::searchDistribution(QList<Distribution*>& distribs, QString name)
-{
-	for(int i = 0; i < distribs.size(); i++)
-	{
-		if(distribs[i]->getProperties().getName() == name)
-			return i;
-	}
-	return -1;
+	//la distribution peut être définie plus loin dans le fichier
+	if(!namedst.isEmpty()) eventDistribMap.insert(levents.size() - 1, namedst);
 }
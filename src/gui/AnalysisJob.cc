@@ -0,0 +1,36 @@
+#include "AnalysisJob.hh"
+
+AnalysisJob::AnalysisJob(QObject *parent, Gate *top, bool useMCS, bool useBoolean, bool useBDD,
+double missionTime, double step, int maxOrder, double cutoff) :
+QThread(parent), top(top), useMCS(useMCS), useBoolean(useBoolean), useBDD(useBDD),
+missionTime(missionTime), step(step), maxOrder(maxOrder), cutoff(cutoff), result(nullptr)
+{
+	timer.setInterval(100);
+	connect(&timer, &QTimer::timeout, this, [this]() { emit progressChanged(progress.getDone(), progress.getTotal()); });
+	connect(this, &QThread::started, &timer, QOverload<>::of(&QTimer::start));
+	connect(this, &QThread::finished, &timer, &QTimer::stop);
+}
+
+AnalysisJob::~AnalysisJob()
+{
+	progress.cancel();
+	wait();
+	delete result;
+}
+
+Result *AnalysisJob::takeResult()
+{
+	Result *r = result;
+	result = nullptr;
+	return (r);
+}
+
+void AnalysisJob::cancel()
+{
+	progress.cancel();
+}
+
+void AnalysisJob::run()
+{
+	result = new Result(top, useMCS, useBoolean, useBDD, missionTime, step, maxOrder, cutoff, &progress);
+}
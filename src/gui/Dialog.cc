@@ -1,3 +1,4 @@
+#include <cfloat>
 #include <limits>
 #include "Dialog.hh"
 
@@ -12,6 +13,7 @@ void ChooseDistributionDialog::confirm()
 	else
 		dist = new Weibull(name);
 	editor.getDistributions() << dist; // Append new distribution to list
+	editor.addName(name);
 	accept();
 }
 
@@ -62,7 +64,7 @@ void PropertiesDialog::checkName(const QString &text)
 		isValid = true;
 		nameWidget->setToolTip("");
 		nameWidget->setStyleSheet("");
-		prop->setName(s);
+		editor.rename(*prop, s);
 	}
 	else
 	{
@@ -110,7 +112,9 @@ bool PropertiesDialog::valid()
 
 void ChooseResultDialog::confirm()
 {
-	if (useBoolean->isChecked())
+	if (running)
+		return ;
+	if (useBoolean->isChecked() || useBDD->isChecked())
 	{
 		QString s;
 		if (missionTime->value() > 0.0 && step->value() == 0.0)
@@ -127,20 +131,54 @@ void ChooseResultDialog::confirm()
 			return ;
 		}
 	}
-	results << new Result(top, useMCS->isChecked(), useBoolean->isChecked(),
-	missionTime->value(), step->value()); // Add new analysis to the list
+	AnalysisJob job(this, top, useMCS->isChecked(), useBoolean->isChecked(), useBDD->isChecked(),
+	missionTime->value(), step->value(), maxOrder->value(), cutoff->value());
+	QProgressDialog bar("Analysis in progress...", "Cancel", 0, 0, this);
+	bar.setWindowTitle("Evaluate");
+	bar.setWindowModality(Qt::WindowModal); // the tree must not change during the analysis
+	bar.setMinimumDuration(500);
+	bar.setAutoReset(false);
+	connect(&job, &AnalysisJob::progressChanged, &bar, [&bar](int done, int total)
+	{
+		bar.setMaximum(total); // busy indicator if unknown
+		bar.setValue(total ? done : 0);
+	});
+	connect(&bar, &QProgressDialog::canceled, &job, &AnalysisJob::cancel);
+	QEventLoop loop;
+	connect(&job, &QThread::finished, &loop, &QEventLoop::quit);
+	running = true;
+	continueButton->setEnabled(false); // no second analysis before the progress dialog shows up
+	job.start();
+	loop.exec(); // keeps the user interface responsive until the analysis ends
+	continueButton->setEnabled(true);
+	running = false;
+	Result *result = job.takeResult();
+	if (result->isCanceled())
+	{
+		delete result;
+		return ; // back to the settings
+	}
+	results << result; // Add new analysis to the list
 	accept();
 }
 
+void ChooseResultDialog::reject()
+{
+	if (!running)
+		QDialog::reject();
+}
+
 void ChooseResultDialog::checkChanged(int state)
 {
 	(void)state;
-	missionTime->setEnabled(useBoolean->isChecked() || useMCS->isChecked());
-	step->setEnabled(useBoolean->isChecked());
+	missionTime->setEnabled(useBoolean->isChecked() || useMCS->isChecked() || useBDD->isChecked());
+	step->setEnabled(useBoolean->isChecked() || useBDD->isChecked());
+	maxOrder->setEnabled(useMCS->isChecked());
+	cutoff->setEnabled(useMCS->isChecked());
 }
 
 ChooseResultDialog::ChooseResultDialog(QWidget *parent, Gate *top, QList<Result*> &results)
-: QDialog(parent), top(top), results(results)
+: QDialog(parent), top(top), results(results), running(false)
 {
 	setWindowTitle("Fault tree analysis");
 	setWindowIcon(QIcon(":icons/evaluate.png"));
@@ -155,6 +193,8 @@ ChooseResultDialog::ChooseResultDialog(QWidget *parent, Gate *top, QList<Result*
 	useBoolean->setToolTip("Use Boolean algebra to calculate the probabilities of failure of the top event");
 	useMCS = linker.addCheckBox("Find MCS");
 	useMCS->setToolTip("Calculate the minimal cuts sets and their probability of failure with MOCUS");
+	useBDD = linker.addCheckBox("Use binary decision diagram");
+	useBDD->setToolTip("Compile the tree into a binary decision diagram to calculate the exact probabilities of failure of the top event");
 	linker.addLabel("Mission time :")->setToolTip("Maximum operating time");;
 	missionTime = linker.addDoubleSpinBox();
 	missionTime->setSuffix(" s");
@@ -167,13 +207,25 @@ ChooseResultDialog::ChooseResultDialog(QWidget *parent, Gate *top, QList<Result*
 	step->setRange(0, std::numeric_limits<double>::max());
 	missionTime->setValue(0);
 	step->setEnabled(false);
-	auto *button2 = linker.addOKButton(false);
-	button2->setText("Continue");
+	linker.addLabel("Maximum order :")->setToolTip("Cut sets with more events are discarded");
+	maxOrder = linker.addSpinBox();
+	maxOrder->setRange(0, std::numeric_limits<int>::max());
+	maxOrder->setSpecialValueText("No limit");
+	maxOrder->setEnabled(false);
+	linker.addLabel("Probability cutoff :")->setToolTip("Cut sets less likely than this value are discarded during the expansion");
+	cutoff = linker.addDoubleSpinBox();
+	cutoff->setRange(0, 1);
+	cutoff->setDecimals(DBL_MAX_10_EXP + DBL_DIG); // 1e-15 must not be rounded to 0 (no cutoff)
+	cutoff->setValue(0);
+	cutoff->setEnabled(false);
+	continueButton = linker.addOKButton(false);
+	continueButton->setText("Continue");
 	resize(340, height());
 
 	connect(useBoolean, SIGNAL(stateChanged(int)), this, SLOT(checkChanged(int)));
 	connect(useMCS, SIGNAL(stateChanged(int)), this, SLOT(checkChanged(int)));
-	connect(button2, SIGNAL(released()), this, SLOT(confirm()));
+	connect(useBDD, SIGNAL(stateChanged(int)), this, SLOT(checkChanged(int)));
+	connect(continueButton, SIGNAL(released()), this, SLOT(confirm()));
 }
 
 ChooseTreeDialog::ChooseTreeDialog(QWidget *parent, Editor &editor, int &treeIndex) :
@@ -50,6 +50,7 @@ MainWindow::MainWindow() : editor(nullptr), fileManager(nullptr), modified(false
 	viewLayout->setContentsMargins(0, 0, 0, 0);
 	scene = new QGraphicsScene(this);
 	view->setScene(scene);
+	renderer = new RenderVisitor(*this);
 
 	viewLayout->addWidget(view);
 
@@ -77,6 +78,10 @@ MainWindow::MainWindow() : editor(nullptr), fileManager(nullptr), modified(false
 	fileManager = new FileManagerSystem;
 	this->newFile();
 
+	autosaveTimer = new QTimer(this);
+	connect(autosaveTimer, SIGNAL(timeout()), this, SLOT(autosave()));
+	autosaveTimer->start(AUTOSAVE_INTERVAL);
+
 	connect(scene, SIGNAL(selectionChanged()), this, SLOT(changeItem()));
 	connect(explorer, SIGNAL(itemClicked(QTreeWidgetItem *, int)),
 	this, SLOT(explorerItemClicked(QTreeWidgetItem *, int)));
@@ -89,6 +94,7 @@ void MainWindow::newFile()
 	if (!maybeSave())
 		return ;
 	scene->clear();
+	renderer->clear();
 	reset();
 	fileManager->setPath("");
 	editor = new Editor();
@@ -109,11 +115,25 @@ void MainWindow::open()
 	"Open-PSA project (*.opsa);;All Files (*)");
 	if (path.isEmpty())
 		return ;
-	auto newEditor = fileManager->load(path);
+	Editor *newEditor = nullptr;
+	bool recovered = false;
+	if (fileManager->hasJournal(path))
+	{
+		const QMessageBox::StandardButton ret = QMessageBox::question(this, "FTEdit",
+		"This project has unsaved changes from a previous session. Do you want to restore them?");
+		if (ret == QMessageBox::Yes)
+			recovered = (newEditor = fileManager->recover(path)) != nullptr;
+		else
+			fileManager->discardJournal(path);
+	}
+	if (!newEditor)
+		newEditor = fileManager->load(path);
 	if (newEditor)
 	{
 		scene->clear();
+		renderer->clear();
 		reset();
+		modified = recovered;
 		setWindowTitle("FTEdit - " + path.mid(path.lastIndexOf("/") + 1));
 		editor = newEditor;
 		auto &list = editor->getTrees();
@@ -177,6 +197,14 @@ void MainWindow::saveAs()
 	fileManager->setPath("");
 }
 
+void MainWindow::autosave()
+{
+	if (!modified || !editor)
+		return ;
+	if (fileManager->autosave(editor))
+		statusBar()->showMessage(fileManager->getErrorMessage(), AUTOSAVE_INTERVAL);
+}
+
 void MainWindow::closeEvent(QCloseEvent* e)
 {
 	if (!maybeSave() || modified)
@@ -244,6 +272,7 @@ void MainWindow::addEvent()
 	modified = true;
 	QList<Event> &events = editor->getEvents();
 	events << Event(editor->generateName(PREFIX_EVENT));
+	editor->addName(events.last().getProperties().getName());
 	auto cont = new Container(&events.last());
 	cont->attach((Gate*)curItem->node());
 	updateScene(curItem->node());
@@ -342,7 +371,7 @@ void MainWindow::evaluate()
 		msg.exec();
 		return ;
 	}
-	if (!result->getResultBoolean() && !result->getResultMCS())
+	if (!result->getResultBoolean() && !result->getResultMCS() && !result->getResultBDD())
 	{
 		resultsHistory.removeLast(); // Discard result
 		QMessageBox msg(this);
@@ -380,6 +409,7 @@ void MainWindow::moveItemFirst()
 	modified = true;
 	QList<Node*> &l = curItem->node()->getParent()->getChildren();
 	l.move(l.indexOf(curItem->node()), 0);
+	curItem->node()->getParent()->invalidateLayout();
 	updateScene(curItem->node());
 }
 
@@ -389,6 +419,7 @@ void MainWindow::moveItemLeft()
 	QList<Node*> &l = curItem->node()->getParent()->getChildren();
 	int pos = l.indexOf(curItem->node());
 	l.move(pos, pos - 1);
+	curItem->node()->getParent()->invalidateLayout();
 	updateScene(curItem->node());
 }
 
@@ -398,6 +429,7 @@ void MainWindow::moveItemRight()
 	QList<Node*> &l = curItem->node()->getParent()->getChildren();
 	int pos = l.indexOf(curItem->node());
 	l.move(pos, pos + 1);
+	curItem->node()->getParent()->invalidateLayout();
 	updateScene(curItem->node());
 }
 
@@ -406,6 +438,7 @@ void MainWindow::moveItemLast()
 	modified = true;
 	QList<Node*> &l = curItem->node()->getParent()->getChildren();
 	l.move(l.indexOf(curItem->node()), l.size() - 1);
+	curItem->node()->getParent()->invalidateLayout();
 	updateScene(curItem->node());
 }
 
@@ -485,7 +518,8 @@ void MainWindow::changeItem()
 	QList<QGraphicsItem*> list = scene->selectedItems();
 	if (list.size() != 1)
 	{
-		curItem->setSelected(!list.size());
+		if (curItem)
+			curItem->setSelected(!list.size());
 		return ;
 	}
 	curItem = (NodeItem*)list[0];
@@ -580,6 +614,7 @@ void MainWindow::removeTree()
 		tree->getTop()->remove();
 		tree->setTop(nullptr);
 	}
+	editor->removeName(tree->getProperties().getName());
 	editor->getTrees().removeAt(selectedRow);
 	editor->refresh();
 	if (selectedRow < curTreeRow)
@@ -816,6 +851,11 @@ void MainWindow::createActions()
 	newTransfertAct->setIcon(QIcon(":objects/transfert.png"));
 	connect(newTransfertAct, &QAction::triggered, this, &MainWindow::newTransfert);
 
+	collapseItemAct = new QAction("Collapse", this);
+	collapseItemAct->setCheckable(true);
+	collapseItemAct->setStatusTip("Hide or show the nodes under the selected gate");
+	connect(collapseItemAct, &QAction::triggered, this, &MainWindow::collapse);
+
 	editTreePropertiesAct = new QAction("Properties", this);
 	editTreePropertiesAct->setStatusTip("Edit the properties of the fault tree");
 	editTreePropertiesAct->setIcon(QIcon(":icons/edit.png"));
@@ -882,6 +922,7 @@ void MainWindow::createMenus()
 	m->addAction(detachItemAct);
 	m->addAction(joinItemAct);
 	m->addAction(newTransfertAct);
+	m->addAction(collapseItemAct);
 
 	m = menuBar()->addMenu("&View");
 	m->addAction(zoomInAct);
@@ -915,6 +956,8 @@ void MainWindow::createMenus()
 	itemsMenu->addAction(detachItemAct);
 	itemsMenu->addAction(joinItemAct);
 	itemsMenu->addAction(newTransfertAct);
+	itemsMenu->addSeparator();
+	itemsMenu->addAction(collapseItemAct);
 }
 
 void MainWindow::createToolBar()
@@ -966,6 +1009,8 @@ bool MainWindow::maybeSave()
 		save();
 		return (!fileManager->getPath().isEmpty() && fileManager->getErrorMessage().isEmpty());
 	}
+	if (!fileManager->getPath().isEmpty())
+		fileManager->discardJournal(fileManager->getPath());
 	modified = false;
 	return (true);
 }
@@ -1020,6 +1065,8 @@ void MainWindow::setEnabledButton()
 	detachItemAct->setEnabled(isNotChild);
 	joinItemAct->setEnabled(isNotChild && editor->getTrees().size() > 1);
 	newTransfertAct->setEnabled(isNotChild && curItem->node()->getParent());
+	collapseItemAct->setEnabled(isNotChild && ((Gate*)curItem->node())->getChildren().size());
+	collapseItemAct->setChecked(isNotChild && ((Gate*)curItem->node())->isCollapsed());
 	addAndAct->setDisabled(isChild);
 	addInhibitAct->setDisabled(isChild);
 	addOrAct->setDisabled(isChild);
@@ -1034,6 +1081,7 @@ void MainWindow::addGate(Gate *g)
 {
 	modified = true;
 	editor->getGates() << g;
+	editor->addName(g->getProperties().getName());
 	if (curItem)
 	{
 		g->attach((Gate*)curItem->node());
@@ -1046,21 +1094,27 @@ void MainWindow::addGate(Gate *g)
 
 void MainWindow::updateScene(Node *selection)
 {
-	scene->clear();
 	Node *top = editor->getSelection()->getTop();
 	if (top)
-	{
 		top->balanceNodePos(); // Reset node position
-		RenderVisitor visitor(*this, selection);
-		top->accept(visitor);
+	{
+		const QSignalBlocker blocker(scene); // curItem is set below
+		renderer->render(top, selection);
 	}
-	else // Reset to empty tree
-		curItem = nullptr;
+	curItem = renderer->item(selection);
 	scene->setSceneRect(scene->itemsBoundingRect());
 	view->update();
 	setEnabledButton();
 }
 
+// Only changes the view: the file is not modified
+void MainWindow::collapse()
+{
+	Gate *g = (Gate*)curItem->node();
+	g->setCollapsed(!g->isCollapsed());
+	updateScene(g);
+}
+
 QMenu *MainWindow::itemsContextMenu()
 {
 	return (itemsMenu);
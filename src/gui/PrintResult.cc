@@ -18,10 +18,10 @@ void PrintResult::exportResult()
 	msg.exec();
 }
 
-void PrintResult::initBoolean(ResultBoolean *res)
+void PrintResult::initProbabilities(QTableWidget *table, Evaluator *res)
 {
 	QList<double> l = res->getProbabilities();
-	prb->setRowCount(l.size());
+	table->setRowCount(l.size());
 	double t = 0;
 	int i = 0;
 	for (double p : l)
@@ -29,12 +29,12 @@ void PrintResult::initBoolean(ResultBoolean *res)
 		// Time
 		auto item = new QTableWidgetItem(DoubleSpinBox::toStringNotFilled(t, 'e', 12));
 		item->setToolTip(DoubleSpinBox::toStringNotFilled(t, 'f', 12));
-		prb->setItem(i, 0, item);
+		table->setItem(i, 0, item);
 
 		// Failure rate
 		item = new QTableWidgetItem(DoubleSpinBox::toStringNotFilled(p, 'e', 12));
 		item->setToolTip(DoubleSpinBox::toStringNotFilled(p, 'f', 12));
-		prb->setItem(i, 1, item);
+		table->setItem(i, 1, item);
 
 		t += res->getStep();
 		++i;
@@ -69,6 +69,26 @@ void PrintResult::initMCS(ResultMCS *res)
 	}
 }
 
+QTableWidget *PrintResult::addProbabilitiesTab(QTabWidget *tabs, const QString &title, const QString &header)
+{
+	auto l = new QVBoxLayout;
+	l->setMargin(1);
+	auto w = new QWidget;
+	w->setLayout(l);
+
+	auto table = new QTableWidget(this);
+	table->setColumnCount(2);
+	table->setHorizontalHeaderLabels(QStringList() << "Time" << header);
+	table->setSortingEnabled(true);
+	table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	table->verticalHeader()->setVisible(false);
+	table->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+	table->horizontalHeader()->setStretchLastSection(true);
+	l->addWidget(table);
+	tabs->addTab(w, title);
+	return (table);
+}
+
 PrintResult::PrintResult(QWidget *parent, Result *result, QString date) :
 QDialog(parent), result(result), date(date)
 {
@@ -94,24 +114,15 @@ QDialog(parent), result(result), date(date)
 	QWidget *w;
 	if (result->getResultBoolean())
 	{
-		l = new QVBoxLayout;
-		l->setMargin(1);
-		w = new QWidget;
-		w->setLayout(l);
-
-		prb = new QTableWidget(this);
-		prb->setColumnCount(2);
-		header << "Time" << "Failure rate of " + result->getResultBoolean()->getTopEventName();
-		prb->setHorizontalHeaderLabels(header);
-		header.clear();
-		prb->setSortingEnabled(true);
-		prb->setEditTriggers(QAbstractItemView::NoEditTriggers);
-		prb->verticalHeader()->setVisible(false);
-		prb->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-		prb->horizontalHeader()->setStretchLastSection(true);
-		l->addWidget(prb);
-		tabs->addTab(w, QString("Probabilities"));
-		initBoolean(result->getResultBoolean());
+		prb = addProbabilitiesTab(tabs, "Probabilities",
+		"Failure rate of " + result->getResultBoolean()->getTopEventName());
+		initProbabilities(prb, result->getResultBoolean());
+	}
+	if (result->getResultBDD())
+	{
+		bdd = addProbabilitiesTab(tabs, "Exact probabilities",
+		"Exact failure probability of " + result->getResultBDD()->getTopEventName());
+		initProbabilities(bdd, result->getResultBDD());
 	}
 	if (result->getResultMCS())
 	{
@@ -124,6 +135,18 @@ QDialog(parent), result(result), date(date)
 		label->setText("TopEvent propability risk: " + DoubleSpinBox::toStringNotFilled(result->getResultMCS()->getProbabilities().last(), 'e', 4));
 		label->setToolTip(DoubleSpinBox::toStringNotFilled(result->getResultMCS()->getProbabilities().last(), 'f', 12));
 		l->addWidget(label);
+		ResultMCS *res = result->getResultMCS();
+		if (res->getMaxOrder() || res->getCutoff() > 0)
+		{
+			QString s("Truncated at");
+			if (res->getMaxOrder())
+				s += " order " + QString::number(res->getMaxOrder());
+			if (res->getMaxOrder() && res->getCutoff() > 0)
+				s += " and";
+			if (res->getCutoff() > 0)
+				s += " probability " + DoubleSpinBox::toStringNotFilled(res->getCutoff(), 'e', 4);
+			l->addWidget(new QLabel(s));
+		}
 
 		mcs = new QTableWidget;
 		mcs->setColumnCount(3);
@@ -2,9 +2,13 @@
 
 NodeItem::NodeItem(QMenu *contextMenu, QPixmap icon, Node *n, Properties *prop, bool isChild) :
 QGraphicsRectItem(n->getPosition().x(), n->getPosition().y(), CARD_X, CARD_Y),
-contextMenu(contextMenu), icon(icon), n(n), prop(prop), child(isChild)
+contextMenu(contextMenu), icon(icon), n(n), prop(prop), child(isChild), origin(n->getPosition())
 {
 	setFlag(ItemIsSelectable);
+	name.setTextFormat(Qt::PlainText);
+	name.setPerformanceHint(QStaticText::AggressiveCaching);
+	desc.setTextFormat(Qt::PlainText);
+	desc.setPerformanceHint(QStaticText::AggressiveCaching);
 }
 
 bool NodeItem::isChild()
@@ -17,25 +21,46 @@ Node *NodeItem::node()
 	return (n);
 }
 
+Properties *NodeItem::properties()
+{
+	return (prop);
+}
+
 void NodeItem::setProperties(Properties *prop)
 {
 	this->prop = prop;
 	scene()->update();
 }
 
-QRectF NodeItem::boundingRect() const
+bool NodeItem::hasIcon(const QPixmap &icon)
 {
-	return QRectF(n->getPosition().x(), n->getPosition().y(), CARD_X, CARD_Y);
+	return (this->icon.cacheKey() == icon.cacheKey());
+}
+
+bool NodeItem::updatePosition()
+{
+	if (origin == n->getPosition())
+		return (false);
+	origin = n->getPosition();
+	setRect(origin.x(), origin.y(), CARD_X, CARD_Y); // Also moves the shape used by clicks and selections
+	return (true);
 }
 
 void NodeItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-	(void)option;
 	(void)widget;
-	QRectF r = boundingRect();
+	QRectF r = rect();
 	r.setX(r.x() + 4 * BORDER_SIZE);
 	r.setWidth(r.width() - 4 * BORDER_SIZE);
 	r.setHeight(r.height() - ICON_RSIZE);
+	if (option->levelOfDetailFromTransform(painter->worldTransform()) < LOD_TEXT)
+	{
+		// A few pixels on the screen: no text, icon nor antialiasing
+		painter->setPen(QPen(Qt::black, 0));
+		painter->setBrush(isSelected() ? QColor(0xfff59e) : Qt::white);
+		painter->drawRect(r);
+		return ;
+	}
 	QPen pen(Qt::black, BORDER_SIZE);
 	painter->setPen(pen);
 	painter->setRenderHint(QPainter::Antialiasing);
@@ -47,6 +72,15 @@ void NodeItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 	painter->drawPath(path);
 	QPointF p(r.center().x() - ICON_RSIZE / 2, r.y() + 1.89 * ICON_RSIZE + BORDER_SIZE - 1);
 	painter->drawPixmap(p, icon);
+	Gate *g = dynamic_cast<Gate*>(n);
+	if (g && g->isCollapsed() && g->getChildren().size()) // Hidden children
+	{
+		QPointF c(r.right() - ICON_RSIZE / 4, r.bottom() + ICON_RSIZE / 4);
+		painter->setBrush(Qt::white);
+		painter->drawEllipse(c, ICON_RSIZE / 8, ICON_RSIZE / 8);
+		painter->drawLine(c - QPointF(ICON_RSIZE / 16, 0), c + QPointF(ICON_RSIZE / 16, 0));
+		painter->drawLine(c - QPointF(0, ICON_RSIZE / 16), c + QPointF(0, ICON_RSIZE / 16));
+	}
 	if (prop)
 	{
 		QFont font = painter->font();
@@ -54,10 +88,21 @@ void NodeItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 		painter->setFont(font);
 		QRect r2(r.x() + ICON_RSIZE / 8, r.y() + ICON_RSIZE / 8,
 		r.width() - ICON_RSIZE / 4, r.height() / 4 - BORDER_SIZE);
-		painter->drawText(r2, Qt::AlignLeft, prop->getName());
+		if (name.text() != prop->getName())
+			name.setText(prop->getName());
+		painter->save();
+		painter->setClipRect(r2, Qt::IntersectClip);
+		painter->drawStaticText(r2.topLeft(), name);
+		painter->restore();
 		r2.setY(r.y() + r.height() / 4);
 		r2.setHeight(r.height() - r.height() / 4 - BORDER_SIZE);
-		painter->drawText(r2, Qt::TextWordWrap, prop->getDesc());
+		if (desc.text() != prop->getDesc() || desc.textWidth() != r2.width())
+		{
+			desc.setText(prop->getDesc());
+			desc.setTextWidth(r2.width()); // Word wrap
+		}
+		painter->setClipRect(r2, Qt::IntersectClip);
+		painter->drawStaticText(r2.topLeft(), desc);
 	}
 }
 
@@ -75,99 +120,174 @@ void NodeItem::contextMenuEvent(QGraphicsSceneContextMenuEvent *event)
 	contextMenu->exec(event->screenPos()); // Calls MainWindow dedicated context menu
 }
 
-RenderVisitor::RenderVisitor(MainWindow &win, Node *selection) :
-win(win), selection(selection)
+RenderVisitor::RenderVisitor(MainWindow &win) :
+win(win), selection(nullptr)
 {}
 
-// Visits the children of gate recursively
-static void visitChildren(MainWindow &win, Gate &gate, RenderVisitor &visitor)
+void RenderVisitor::render(Node *top, Node *selection)
+{
+	this->selection = selection;
+	visited.clear();
+	if (top)
+		top->accept(*this);
+	// Removes the items of the nodes no longer displayed
+	for (auto i = items.begin(); i != items.end();)
+	{
+		if (visited.contains(i.key()))
+			++i;
+		else
+		{
+			delete i.value();
+			i = items.erase(i);
+		}
+	}
+	for (auto i = links.begin(); i != links.end();)
+	{
+		if (visited.contains(i.key()))
+			++i;
+		else
+		{
+			delete i.value();
+			i = links.erase(i);
+		}
+	}
+}
+
+void RenderVisitor::clear()
+{
+	items.clear();
+	links.clear();
+	visited.clear();
+}
+
+NodeItem *RenderVisitor::item(Node *node)
+{
+	return (items.value(node));
+}
+
+// The connectors of node are only redrawn if their geometry changed
+void RenderVisitor::setLinks(Node *node, const QPainterPath &path)
+{
+	QGraphicsPathItem *item = links.value(node);
+	if (path.isEmpty())
+	{
+		delete item;
+		links.remove(node);
+	}
+	else if (!item)
+	{
+		item = new QGraphicsPathItem(path);
+		item->setBrush(Qt::black);
+		item->setZValue(-1); // Under the cards
+		win.getScene()->addItem(item);
+		links.insert(node, item);
+	}
+	else if (item->path() != path)
+		item->setPath(path);
+}
+
+void RenderVisitor::setItem(Node &node, const QPixmap &icon, Properties *prop, bool isChild)
+{
+	visited.insert(&node);
+	NodeItem *n = items.value(&node);
+	if (n && !n->hasIcon(icon)) // Address of a deleted node reused by another kind of node
+	{
+		delete n;
+		n = nullptr;
+	}
+	if (!n)
+	{
+		n = new NodeItem(win.itemsContextMenu(), icon, &node, prop, isChild);
+		win.getScene()->addItem(n);
+		items.insert(&node, n);
+	}
+	else
+	{
+		n->updatePosition();
+		if (n->properties() != prop)
+			n->setProperties(prop);
+	}
+	if (isChild && links.contains(&node)) // Was a gate
+		delete links.take(&node);
+	n->setSelected(&node == selection);
+}
+
+// Visits the children of gate recursively, the children of a collapsed gate get no item
+void RenderVisitor::visitChildren(Gate &gate)
 {
 	QList<Node*> &l = gate.getChildren();
+	QPainterPath path;
+	path.setFillRule(Qt::WindingFill); // The bars overlap
+	if (gate.isCollapsed())
+	{
+		setLinks(&gate, path);
+		return ;
+	}
 	QPoint p;
 	if (l.size()) // Draw connections
 	{
 		p = l[0]->getPosition();
 		QPoint p2(l.last()->getPosition());
-		QGraphicsRectItem *item = new QGraphicsRectItem(p.x() + CARD_X / 2,
-		p.y() - CARD_GAP_Y / 2 - BORDER_SIZE, p2.x() - p.x(), 2 * BORDER_SIZE);
-		item->setBrush(Qt::black);
-		win.getScene()->addItem(item);
+		path.addRect(p.x() + CARD_X / 2, p.y() - CARD_GAP_Y / 2 - BORDER_SIZE, p2.x() - p.x(), 2 * BORDER_SIZE);
 		p = gate.getPosition();
-		item = new QGraphicsRectItem(p.x() + CARD_X / 2 - BORDER_SIZE,
-		p.y() + CARD_Y - ICON_RSIZE / 2, 2 * BORDER_SIZE, CARD_GAP_Y / 2 + ICON_RSIZE / 2 - BORDER_SIZE);
-		win.getScene()->addItem(item);
-		item->setBrush(Qt::black);
+		path.addRect(p.x() + CARD_X / 2 - BORDER_SIZE, p.y() + CARD_Y - ICON_RSIZE / 2,
+		2 * BORDER_SIZE, CARD_GAP_Y / 2 + ICON_RSIZE / 2 - BORDER_SIZE);
 	}
 	QList<Node*>::const_iterator i;
 	for (i = l.constBegin(); i != l.constEnd(); ++i)
 	{
 		p = (*i)->getPosition();
-		QGraphicsRectItem *item = new QGraphicsRectItem(p.x() + CARD_X / 2 - BORDER_SIZE,
-		p.y() - CARD_GAP_Y / 2 - BORDER_SIZE, 2 * BORDER_SIZE, CARD_GAP_Y / 2 + BORDER_SIZE);
-		item->setBrush(Qt::black);
-		win.getScene()->addItem(item);
-		(*i)->accept(visitor);
+		path.addRect(p.x() + CARD_X / 2 - BORDER_SIZE, p.y() - CARD_GAP_Y / 2 - BORDER_SIZE,
+		2 * BORDER_SIZE, CARD_GAP_Y / 2 + BORDER_SIZE);
+		(*i)->accept(*this);
 	}
+	setLinks(&gate, path);
 }
 
 void RenderVisitor::visit(And &gate)
 {
-	visitChildren(win, gate, *this);
+	visitChildren(gate);
 	static QPixmap icon(QPixmap(":objects/and.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &gate, &gate.getProperties());
-	if (&gate == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
+	setItem(gate, icon, &gate.getProperties());
 }
 
 void RenderVisitor::visit(Or &gate)
 {
-	visitChildren(win, gate, *this);
+	visitChildren(gate);
 	static QPixmap icon(QPixmap(":objects/or.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &gate, &gate.getProperties());
-	if (&gate == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
+	setItem(gate, icon, &gate.getProperties());
 }
 
 void RenderVisitor::visit(Xor &gate)
 {
-	visitChildren(win, gate, *this);
+	visitChildren(gate);
 	static QPixmap icon(QPixmap(":objects/xor.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &gate, &gate.getProperties());
-	if (&gate == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
+	setItem(gate, icon, &gate.getProperties());
 }
 
 void RenderVisitor::visit(VotingOR &gate)
 {
-	visitChildren(win, gate, *this);
+	visitChildren(gate);
 	static QPixmap icon(QPixmap(":objects/kn.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &gate, &gate.getProperties());
-	if (&gate == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
+	setItem(gate, icon, &gate.getProperties());
 }
 
 void RenderVisitor::visit(Inhibit &gate)
 {
-	visitChildren(win, gate, *this);
+	visitChildren(gate);
 	static QPixmap icon(QPixmap(":objects/inhibit.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &gate, &gate.getProperties());
-	if (&gate == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
+	setItem(gate, icon, &gate.getProperties());
 }
 
 void RenderVisitor::visit(Transfert &gate)
 {
 	Properties *prop = gate.getLink() ? &gate.getLink()->getProperties() : nullptr;
 	static QPixmap icon(QPixmap(":objects/transfert.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &gate, prop, true);
-	if (&gate == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
+	setItem(gate, icon, prop, true);
 }
 
 void RenderVisitor::visit(Container &cont)
 {
 	static QPixmap icon(QPixmap(":objects/basicEvent.png").scaled(ICON_RSIZE, ICON_RSIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation));
-	auto n = new NodeItem(win.itemsContextMenu(), icon, &cont, &cont.getEvent()->getProperties(), true);
-	if (&cont == selection) n->setSelected(true);
-	win.getScene()->addItem(n);
-}
\ No newline at end of file
+	setItem(cont, icon, &cont.getEvent()->getProperties(), true);
+}
@@ -8,7 +8,7 @@ QDoubleSpinBox(parent)
 	setAccelerated(true);
 	setLocale(QLocale("C"));
 	connect(this, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
-	[=](double d){ this->setToolTip(toStringNotFilled(d, 'f', 12)); });
+	[=](double d){ this->setToolTip(toStringNotFilled(d, d && qAbs(d) < 1e-12 ? 'e' : 'f', 12)); });
 }
 
 QString DoubleSpinBox::textFromValue(double d) const
@@ -16,6 +16,34 @@ QString DoubleSpinBox::textFromValue(double d) const
 	return (toStringNotFilled(d, 'e', 12));
 }
 
+QString DoubleSpinBox::stripped(const QString &text) const
+{
+	QString s(text);
+	if (prefix().size() && s.startsWith(prefix()))
+		s.remove(0, prefix().size());
+	if (suffix().size() && s.endsWith(suffix()))
+		s.chop(suffix().size());
+	return (s.trimmed());
+}
+
+double DoubleSpinBox::valueFromText(const QString &text) const
+{
+	return (QLocale("C").toDouble(stripped(text)));
+}
+
+QValidator::State DoubleSpinBox::validate(QString &text, int &pos) const
+{
+	(void)pos;
+	bool ok;
+	QString s(stripped(text));
+	double d = QLocale("C").toDouble(s, &ok);
+	if (ok)
+		return (d >= minimum() && d <= maximum() ? QValidator::Acceptable : QValidator::Intermediate);
+	// Number being typed, e.g. "1e-"
+	static const QRegularExpression partial("^\\s*[+-]?\\d*\\.?\\d*([eE][+-]?\\d*)?\\s*$");
+	return (partial.match(s).hasMatch() ? QValidator::Intermediate : QValidator::Invalid);
+}
+
 QString DoubleSpinBox::toStringNotFilled(double d, char f, int prec)
 {
 	QLocale l("C");